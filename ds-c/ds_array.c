@@ -89,14 +89,14 @@ void ds_array_destroy(ds_array * array)
     free(array);
 }
 
-ds_size ds_array_length(const ds_array * array)
+ds_size (ds_array_length)(const ds_array * array)
 {
-    return array->count;
+    return _ds_array_length(array);
 }
 
-ds_bool ds_array_empty(const ds_array * array)
+ds_bool (ds_array_empty)(const ds_array * array)
 {
-    return array->count == 0;
+    return _ds_array_empty(array);
 }
 
 void ds_array_clear(ds_array * array)
@@ -127,12 +127,9 @@ void ds_array_erase(ds_array * array, const ds_size index)
     _array_erase(array, dest);
 }
 
-ds_data * ds_array_at(const ds_array * array, ds_size index)
+ds_data * (ds_array_at)(const ds_array * array, ds_size index)
 {
-    //assert(0 <= index && index < array->count);
-    ds_byte * ptr = (ds_byte *)array->items;
-    ptr += index * array->item_size;
-    return (ds_data *)ptr;
+    return _ds_array_at(array, index);
 }
 
 ds_size ds_array_find(const ds_array * array, const ds_data data)
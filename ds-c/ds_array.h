@@ -124,4 +124,28 @@ void ds_array_sort_insert(ds_array * array, const ds_data item);
  */
 ds_array * ds_array_copy(const ds_array * array);
 
+#pragma mark - Inline accessors
+
+static inline ds_size _ds_array_length(const ds_array * array)
+{
+    return array->count;
+}
+
+static inline ds_bool _ds_array_empty(const ds_array * array)
+{
+    return array->count == 0;
+}
+
+static inline ds_data * _ds_array_at(const ds_array * array, const ds_size index)
+{
+    //assert(0 <= index && index < array->count);
+    return (ds_data *)((ds_byte *)array->items + index * array->item_size);
+}
+
+#if DS_INLINE
+#define ds_array_length(array)       _ds_array_length(array)
+#define ds_array_empty(array)        _ds_array_empty(array)
+#define ds_array_at(array, index)    _ds_array_at(array, index)
+#endif
+
 #endif /* defined(__ds_array__) */
@@ -0,0 +1,160 @@
+//
+//  ds_atomic_stack.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_atomic_stack.h"
+
+static inline void _atomic_push(_Atomic(ds_atomic_top) * top,
+                                ds_atomic_node * first, ds_atomic_node * last)
+{
+    ds_atomic_top old = atomic_load_explicit(top, memory_order_relaxed);
+    ds_atomic_top new;
+    do {
+        last->next = old.node;
+        new.node = first;
+        new.tag = old.tag + 1;
+    } while (!atomic_compare_exchange_weak_explicit(top, &old, new,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+static inline ds_atomic_node * _atomic_pop(_Atomic(ds_atomic_top) * top)
+{
+    ds_atomic_top old = atomic_load_explicit(top, memory_order_acquire);
+    ds_atomic_top new;
+    do {
+        if (old.node == NULL) {
+            // empty stack
+            return NULL;
+        }
+        // the node may be popped by another thread right now,
+        // but it will not be freed, and the tag will tell us it changed
+        new.node = old.node->next;
+        new.tag = old.tag + 1;
+    } while (!atomic_compare_exchange_weak_explicit(top, &old, new,
+                                                    memory_order_acquire,
+                                                    memory_order_acquire));
+    old.node->next = NULL;
+    return old.node;
+}
+
+static inline ds_atomic_node * _atomic_pop_all(_Atomic(ds_atomic_top) * top)
+{
+    ds_atomic_top old = atomic_load_explicit(top, memory_order_relaxed);
+    ds_atomic_top new;
+    do {
+        if (old.node == NULL) {
+            return NULL;
+        }
+        new.node = NULL;
+        new.tag = old.tag + 1;
+    } while (!atomic_compare_exchange_weak_explicit(top, &old, new,
+                                                    memory_order_acquire,
+                                                    memory_order_relaxed));
+    return old.node;
+}
+
+static inline void _atomic_free_nodes(ds_atomic_node * node)
+{
+    for (ds_atomic_node * next; node; node = next) {
+        next = node->next;
+        free(node);
+    }
+}
+
+#pragma mark -
+
+void ds_atomic_stack_init(ds_atomic_stack * stack, const ds_size item_size)
+{
+    ds_atomic_top empty = {NULL, 0};
+    atomic_init(&stack->top, empty);
+    atomic_init(&stack->pool, empty);
+    stack->item_size = item_size;
+}
+
+ds_atomic_stack * ds_atomic_stack_create(const ds_size item_size)
+{
+    // aligned to cache line for the padded top pointers
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_atomic_stack)) != 0) {
+        return NULL;
+    }
+    ds_atomic_stack * stack = (ds_atomic_stack *)ptr;
+    ds_atomic_stack_init(stack, item_size);
+    return stack;
+}
+
+void ds_atomic_stack_destroy(ds_atomic_stack * stack)
+{
+    if (stack->item_size > 0) {
+        // nodes created by 'ds_atomic_stack_push'
+        _atomic_free_nodes(_atomic_pop_all(&stack->top));
+    }
+    _atomic_free_nodes(_atomic_pop_all(&stack->pool));
+    free(stack);
+}
+
+ds_bool ds_atomic_stack_empty(ds_atomic_stack * stack)
+{
+    ds_atomic_top top = atomic_load_explicit(&stack->top, memory_order_relaxed);
+    return top.node == NULL;
+}
+
+ds_bool ds_atomic_stack_is_lock_free(ds_atomic_stack * stack)
+{
+    return atomic_is_lock_free(&stack->top) ? DSTrue : DSFalse;
+}
+
+#pragma mark Intrusive
+
+void ds_atomic_stack_push_node(ds_atomic_stack * stack, ds_atomic_node * node)
+{
+    _atomic_push(&stack->top, node, node);
+}
+
+void ds_atomic_stack_push_nodes(ds_atomic_stack * stack,
+                                ds_atomic_node * first, ds_atomic_node * last)
+{
+    _atomic_push(&stack->top, first, last);
+}
+
+ds_atomic_node * ds_atomic_stack_pop_node(ds_atomic_stack * stack)
+{
+    return _atomic_pop(&stack->top);
+}
+
+ds_atomic_node * ds_atomic_stack_pop_all(ds_atomic_stack * stack)
+{
+    return _atomic_pop_all(&stack->top);
+}
+
+#pragma mark By value
+
+void ds_atomic_stack_push(ds_atomic_stack * stack, const ds_data data)
+{
+    //assert(stack->item_size > 0);
+    ds_atomic_node * node = _atomic_pop(&stack->pool);
+    if (node == NULL) {
+        // the payload is stored right after the node
+        node = (ds_atomic_node *)malloc(sizeof(ds_atomic_node) + stack->item_size);
+    }
+    memcpy(ds_atomic_stack_node_data(node), &data, stack->item_size);
+    _atomic_push(&stack->top, node, node);
+}
+
+ds_atomic_node * ds_atomic_stack_pop(ds_atomic_stack * stack)
+{
+    return _atomic_pop(&stack->top);
+}
+
+void ds_atomic_stack_node_recycle(ds_atomic_stack * stack, ds_atomic_node * node)
+{
+    _atomic_push(&stack->pool, node, node);
+}
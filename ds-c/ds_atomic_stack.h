@@ -0,0 +1,131 @@
+//
+//  ds_atomic_stack.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_atomic_stack__
+#define __ds_atomic_stack__
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "ds_base.h"
+
+//
+//  Lock-free stack (Treiber stack)
+//
+//      The top pointer is paired with a tag which increases on every change,
+//  and they are replaced together by a double-width (128-bit on 64-bit)
+//  compare-and-swap, so a node popped and pushed back by other threads
+//  (ABA problem) will never be taken as unchanged.
+//      On x86_64 please build with '-mcx16' to get the CAS instruction inline.
+//
+//  Notice:
+//      A node may still be read by a thread which is popping it concurrently,
+//      so a node removed from the stack must NOT be freed while other threads
+//      are using the stack; give it back by 'ds_atomic_stack_node_recycle()'
+//      (or keep it in your own pool), all nodes are freed when destroying.
+//
+//  Usage:
+//      1. intrusive: put a 'ds_atomic_node' in your struct, init the stack
+//         with 'ds_atomic_stack_init(stack, 0)', push/pop the nodes directly;
+//      2. by value: create the stack with item size, push data and pop nodes,
+//         get data from 'ds_atomic_stack_node_data(node)'.
+//
+
+typedef struct _ds_atomic_node {
+    struct _ds_atomic_node * next;
+} ds_atomic_node;
+
+// payload of the node created by 'ds_atomic_stack_push'
+#define ds_atomic_stack_node_data(node) ((ds_data *)((ds_atomic_node *)(node) + 1))
+
+typedef struct _ds_atomic_top {
+    ds_atomic_node * node;
+    uintptr_t tag; // change counter against ABA
+} ds_atomic_top;
+
+typedef struct _ds_atomic_stack {
+
+    // pushed nodes, top of stack
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(ds_atomic_top) top;
+
+    // recycled nodes, reused by 'ds_atomic_stack_push'
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(ds_atomic_top) pool;
+
+    ds_size item_size; // 0 for intrusive stack
+} ds_atomic_stack;
+
+/**
+ *  initialize a stack struct (e.g.: static or embedded in other struct),
+ *  item_size = 0 for an intrusive stack, which needs no destroying
+ */
+void ds_atomic_stack_init(ds_atomic_stack * stack, const ds_size item_size);
+
+/**
+ *  create a stack with item size (0 for intrusive stack)
+ */
+ds_atomic_stack * ds_atomic_stack_create(const ds_size item_size);
+
+/**
+ *  destroy the stack, free all nodes created by the stack
+ *  (call it when no other thread is using the stack)
+ */
+void ds_atomic_stack_destroy(ds_atomic_stack * stack);
+
+/**
+ *  check whether the stack is empty (just a snapshot)
+ */
+ds_bool ds_atomic_stack_empty(ds_atomic_stack * stack);
+
+/**
+ *  check whether the double-width CAS is lock-free on this platform
+ */
+ds_bool ds_atomic_stack_is_lock_free(ds_atomic_stack * stack);
+
+#pragma mark Intrusive
+
+/**
+ *  push the node to top of the stack
+ */
+void ds_atomic_stack_push_node(ds_atomic_stack * stack, ds_atomic_node * node);
+
+/**
+ *  push a linked nodes (first->...->last) to top of the stack at once,
+ *  'first' will be the new top
+ */
+void ds_atomic_stack_push_nodes(ds_atomic_stack * stack,
+                                ds_atomic_node * first, ds_atomic_node * last);
+
+/**
+ *  remove the top node and return it, or NULL when the stack is empty
+ */
+ds_atomic_node * ds_atomic_stack_pop_node(ds_atomic_stack * stack);
+
+/**
+ *  remove all nodes and return the top one (linked by node->next, LIFO)
+ */
+ds_atomic_node * ds_atomic_stack_pop_all(ds_atomic_stack * stack);
+
+#pragma mark By value
+
+/**
+ *  copy data (item_size) into a node and push it to top of the stack
+ */
+void ds_atomic_stack_push(ds_atomic_stack * stack, const ds_data data);
+
+/**
+ *  remove the top node and return it, or NULL when the stack is empty,
+ *  give it back by 'ds_atomic_stack_node_recycle()' after used
+ */
+ds_atomic_node * ds_atomic_stack_pop(ds_atomic_stack * stack);
+
+/**
+ *  give back the node removed from the stack, to reuse it by next push
+ */
+void ds_atomic_stack_node_recycle(ds_atomic_stack * stack, ds_atomic_node * node);
+
+#endif /* defined(__ds_atomic_stack__) */
@@ -25,6 +25,23 @@ static const int DSFalse = 0;
 
 static const ds_data DSZero =  0;
 
+//
+//  Inline
+//
+//      When 'DS_INLINE' is set, the trivial accessors (length/empty/at) are
+//  also defined as 'static inline' functions in the headers, and the public
+//  names are mapped to them, so the callers can be optimized across; the
+//  exported symbols are still built in the .c files for ABI compatibility.
+//
+#ifndef DS_INLINE
+#define DS_INLINE 1
+#endif
+
+// size of the CPU cache line, for aligning/padding the hot memory blocks
+#ifndef DS_CACHE_LINE_SIZE
+#define DS_CACHE_LINE_SIZE 64
+#endif
+
 enum _ds_comparison_result {
     DSAscending  = -1,  // left < right
     DSSame       =  0,  // left == right
@@ -0,0 +1,209 @@
+//
+//  ds_blocking_queue.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_blocking_queue.h"
+
+// wake at most 'count' threads parking on the word, if any
+static inline void _blocking_queue_notify(atomic_uint * word, atomic_int * waiters,
+                                          const ds_size count)
+{
+    // the change of queue must be visible before checking the waiters
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(waiters, memory_order_relaxed) > 0) {
+        atomic_fetch_add(word, 1);
+        ds_futex_wake(word, count);
+    }
+}
+
+#pragma mark -
+
+ds_blocking_queue * ds_blocking_queue_create(const ds_size item_size,
+                                             const ds_size capacity)
+{
+    // aligned to cache line for the padded words
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_blocking_queue)) != 0) {
+        return NULL;
+    }
+    ds_blocking_queue * queue = (ds_blocking_queue *)ptr;
+    memset(queue, 0, sizeof(ds_blocking_queue));
+    queue->queue = ds_mpmc_queue_create(item_size, capacity);
+    atomic_init(&queue->items_seq, 0);
+    atomic_init(&queue->consumers, 0);
+    atomic_init(&queue->spaces_seq, 0);
+    atomic_init(&queue->producers, 0);
+    atomic_init(&queue->closed, 0);
+    return queue;
+}
+
+void ds_blocking_queue_destroy(ds_blocking_queue * queue)
+{
+    ds_mpmc_queue_destroy(queue->queue);
+    queue->queue = NULL;
+    free(queue);
+}
+
+ds_size ds_blocking_queue_length(ds_blocking_queue * queue)
+{
+    return ds_mpmc_queue_length(queue->queue);
+}
+
+ds_bool ds_blocking_queue_empty(ds_blocking_queue * queue)
+{
+    return ds_mpmc_queue_empty(queue->queue);
+}
+
+void ds_blocking_queue_close(ds_blocking_queue * queue)
+{
+    atomic_store(&queue->closed, 1);
+    // wake up everyone
+    atomic_fetch_add(&queue->items_seq, 1);
+    ds_futex_wake(&queue->items_seq, DS_FUTEX_WAKE_ALL);
+    atomic_fetch_add(&queue->spaces_seq, 1);
+    ds_futex_wake(&queue->spaces_seq, DS_FUTEX_WAKE_ALL);
+}
+
+ds_bool ds_blocking_queue_closed(ds_blocking_queue * queue)
+{
+    return atomic_load(&queue->closed) ? DSTrue : DSFalse;
+}
+
+#pragma mark Producer
+
+ds_blocking_queue_status ds_blocking_queue_push_timeout(ds_blocking_queue * queue,
+                                                        const ds_data item,
+                                                        const uint64_t deadline)
+{
+    unsigned int spins = 0;
+    unsigned int value;
+    ds_bool ok;
+    for (;;) {
+        if (atomic_load_explicit(&queue->closed, memory_order_relaxed)) {
+            return DSBlockingQueueClosed;
+        }
+        if (ds_mpmc_queue_try_push(queue->queue, item)) {
+            _blocking_queue_notify(&queue->items_seq, &queue->consumers, 1);
+            return DSBlockingQueueSuccess;
+        }
+        // 1. spin
+        if (spins < DS_BLOCKING_QUEUE_SPIN_COUNT) {
+            ++spins;
+            ds_cpu_relax();
+            continue;
+        }
+        // 2. register as a parking producer, and check again
+        value = atomic_load(&queue->spaces_seq);
+        atomic_fetch_add(&queue->producers, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (atomic_load(&queue->closed) || !ds_mpmc_queue_try_push(queue->queue, item)) {
+            // 3. park until popped (or closed)
+            ok = atomic_load(&queue->closed) ||
+                 ds_futex_wait(&queue->spaces_seq, value, deadline);
+            atomic_fetch_sub(&queue->producers, 1);
+            if (!ok) {
+                return DSBlockingQueueTimeout;
+            }
+            continue;
+        }
+        atomic_fetch_sub(&queue->producers, 1);
+        _blocking_queue_notify(&queue->items_seq, &queue->consumers, 1);
+        return DSBlockingQueueSuccess;
+    }
+}
+
+ds_blocking_queue_status ds_blocking_queue_push(ds_blocking_queue * queue,
+                                                const ds_data item)
+{
+    return ds_blocking_queue_push_timeout(queue, item, 0);
+}
+
+ds_size ds_blocking_queue_push_n(ds_blocking_queue * queue,
+                                 const ds_data * items, const ds_size count)
+{
+    if (atomic_load_explicit(&queue->closed, memory_order_relaxed)) {
+        return 0;
+    }
+    ds_size n = ds_mpmc_queue_try_push_n(queue->queue, items, count);
+    if (n > 0) {
+        // one wake-up call for all of them
+        _blocking_queue_notify(&queue->items_seq, &queue->consumers, n);
+    }
+    return n;
+}
+
+#pragma mark Consumer
+
+ds_blocking_queue_status ds_blocking_queue_pop_timeout(ds_blocking_queue * queue,
+                                                       ds_data * item,
+                                                       const uint64_t deadline)
+{
+    unsigned int spins = 0;
+    unsigned int value;
+    ds_bool ok;
+    for (;;) {
+        if (ds_mpmc_queue_try_pop(queue->queue, item)) {
+            _blocking_queue_notify(&queue->spaces_seq, &queue->producers, 1);
+            return DSBlockingQueueSuccess;
+        }
+        if (atomic_load(&queue->closed)) {
+            // the items left must be taken before reporting closed
+            if (ds_mpmc_queue_try_pop(queue->queue, item)) {
+                return DSBlockingQueueSuccess;
+            }
+            return DSBlockingQueueClosed;
+        }
+        // 1. spin
+        if (spins < DS_BLOCKING_QUEUE_SPIN_COUNT) {
+            ++spins;
+            ds_cpu_relax();
+            continue;
+        }
+        // 2. register as a parking consumer, and check again
+        value = atomic_load(&queue->items_seq);
+        atomic_fetch_add(&queue->consumers, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (atomic_load(&queue->closed) || !ds_mpmc_queue_try_pop(queue->queue, item)) {
+            // 3. park until pushed (or closed)
+            ok = atomic_load(&queue->closed) ||
+                 ds_futex_wait(&queue->items_seq, value, deadline);
+            atomic_fetch_sub(&queue->consumers, 1);
+            if (!ok) {
+                // last chance
+                if (ds_mpmc_queue_try_pop(queue->queue, item)) {
+                    _blocking_queue_notify(&queue->spaces_seq, &queue->producers, 1);
+                    return DSBlockingQueueSuccess;
+                }
+                return DSBlockingQueueTimeout;
+            }
+            continue;
+        }
+        atomic_fetch_sub(&queue->consumers, 1);
+        _blocking_queue_notify(&queue->spaces_seq, &queue->producers, 1);
+        return DSBlockingQueueSuccess;
+    }
+}
+
+ds_blocking_queue_status ds_blocking_queue_pop(ds_blocking_queue * queue,
+                                               ds_data * item)
+{
+    return ds_blocking_queue_pop_timeout(queue, item, 0);
+}
+
+ds_size ds_blocking_queue_drain(ds_blocking_queue * queue,
+                                ds_data * items, const ds_size max)
+{
+    ds_size n = ds_mpmc_queue_try_pop_n(queue->queue, items, max);
+    if (n > 0) {
+        // one wake-up call for all of them
+        _blocking_queue_notify(&queue->spaces_seq, &queue->producers, n);
+    }
+    return n;
+}
@@ -0,0 +1,137 @@
+//
+//  ds_blocking_queue.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_blocking_queue__
+#define __ds_blocking_queue__
+
+#include "ds_mpmc_queue.h"
+#include "ds_futex.h"
+
+//
+//  Blocking queue
+//
+//      A bounded multi-producer/multi-consumer queue ('ds_mpmc_queue') which
+//  lets the consumers wait for items (and the producers wait for spaces)
+//  without burning CPU: spin for a while first, then park on a futex word,
+//  which is bumped and woken by the other side only when someone is parking.
+//
+//      After closed, pushing fails, and the consumers can still get all the
+//  items left in the queue, then get 'DSBlockingQueueClosed'.
+//
+//      The items follow the 'item_size'/'assign' conventions of the inner
+//  queue, set the hooks to 'queue->queue->fn' or 'queue->queue->bk'.
+//
+
+#ifndef DS_BLOCKING_QUEUE_SPIN_COUNT
+#define DS_BLOCKING_QUEUE_SPIN_COUNT 100
+#endif
+
+enum _ds_blocking_queue_status {
+    DSBlockingQueueSuccess = 0,
+    DSBlockingQueueTimeout = 1,  // deadline passed
+    DSBlockingQueueClosed  = 2,  // closed (and empty for popping)
+};
+typedef int ds_blocking_queue_status;
+
+typedef struct _ds_blocking_queue {
+
+    ds_mpmc_queue * queue;
+
+    // bumped when items pushed, for waking consumers
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_uint items_seq;
+    atomic_int consumers; // count of parking consumers
+
+    // bumped when items popped, for waking producers
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_uint spaces_seq;
+    atomic_int producers; // count of parking producers
+
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_int closed;
+} ds_blocking_queue;
+
+/**
+ *  create a queue struct with item size and capacity (rounded up to power of two)
+ */
+ds_blocking_queue * ds_blocking_queue_create(const ds_size item_size,
+                                             const ds_size capacity);
+
+/**
+ *  destroy the queue struct and its items (no other thread is using it)
+ */
+void ds_blocking_queue_destroy(ds_blocking_queue * queue);
+
+/**
+ *  get items count (just a snapshot)
+ */
+ds_size ds_blocking_queue_length(ds_blocking_queue * queue);
+
+/**
+ *  check whether the queue is empty (just a snapshot)
+ */
+ds_bool ds_blocking_queue_empty(ds_blocking_queue * queue);
+
+/**
+ *  close the queue and wake up all waiting threads
+ */
+void ds_blocking_queue_close(ds_blocking_queue * queue);
+
+/**
+ *  check whether the queue is closed
+ */
+ds_bool ds_blocking_queue_closed(ds_blocking_queue * queue);
+
+#pragma mark Producer
+
+/**
+ *  append the item, wait while the queue is full until the deadline
+ *  (monotonic time from 'ds_futex_now()', 0 for no timeout)
+ */
+ds_blocking_queue_status ds_blocking_queue_push_timeout(ds_blocking_queue * queue,
+                                                        const ds_data item,
+                                                        const uint64_t deadline);
+
+/**
+ *  append the item, wait while the queue is full
+ */
+ds_blocking_queue_status ds_blocking_queue_push(ds_blocking_queue * queue,
+                                                const ds_data item);
+
+/**
+ *  append items as many as possible without waiting,
+ *  and wake up the consumers for them at once
+ *
+ * @return count of pushed items
+ */
+ds_size ds_blocking_queue_push_n(ds_blocking_queue * queue,
+                                 const ds_data * items, const ds_size count);
+
+#pragma mark Consumer
+
+/**
+ *  remove head item and copy it into 'item', wait while the queue is empty
+ *  until the deadline (monotonic time from 'ds_futex_now()', 0 for no timeout)
+ */
+ds_blocking_queue_status ds_blocking_queue_pop_timeout(ds_blocking_queue * queue,
+                                                       ds_data * item,
+                                                       const uint64_t deadline);
+
+/**
+ *  remove head item and copy it into 'item', wait while the queue is empty
+ */
+ds_blocking_queue_status ds_blocking_queue_pop(ds_blocking_queue * queue,
+                                               ds_data * item);
+
+/**
+ *  remove items as many as possible (at most 'max') without waiting,
+ *  and wake up the producers for the spaces at once
+ *
+ * @return count of removed items
+ */
+ds_size ds_blocking_queue_drain(ds_blocking_queue * queue,
+                                ds_data * items, const ds_size max);
+
+#endif /* defined(__ds_blocking_queue__) */
@@ -11,20 +11,24 @@
 
 #include "ds_chain.h"
 
-static inline ds_chain_node * _chain_create_node(const ds_size data_size)
+static inline ds_chain_node * _chain_create_node(ds_chain_table * chain,
+                                                 const ds_size data_size)
 {
     //assert(data_size > 0);
     
-    // 1. create a buffer for the whole struct and data memory
-    ds_size len = sizeof(ds_chain_node) + data_size;
-    ds_byte * ptr = malloc(len);
-    memset(ptr, 0, len);
-    
-    // 2. allocate memories
-    //    the first part (size = sizeof(ds_chain_node)) to store the node struct
-    //    the rest part (size = chain->data_size) to store the data
-    ds_chain_node * node = (ds_chain_node *)ptr;
-    node->data = (ds_data *)(ptr + sizeof(ds_chain_node));
+    // 1. reuse a recycled node if it is big enough
+    ds_chain_node * node = chain->pool;
+    if (node && node->data_size >= data_size) {
+        chain->pool = node->next;
+        chain->pool_count -= 1;
+    } else {
+        // 2. create a buffer for the whole struct and data memory
+        //    the first part (size = sizeof(ds_chain_node)) to store the node struct
+        //    the rest part (size = data_size) to store the data
+        node = (ds_chain_node *)malloc(sizeof(ds_chain_node) + data_size);
+    }
+    // the payload will be assigned by the caller, no need to clear it here
+    node->next = NULL;
     node->data_size = data_size;
     
     return node;
@@ -32,19 +36,40 @@ static inline ds_chain_node * _chain_create_node(const ds_size data_size)
 
 static inline void _chain_destroy_node(ds_chain_node * node)
 {
-    // the node->data points to the memory after this node,
+    // the payload is in the memory after this node,
     // it will be free at the same time
     free(node);
 }
 
+static inline void _chain_recycle_node(ds_chain_table * chain, ds_chain_node * node)
+{
+    if (chain->pool_count < chain->pool_capacity) {
+        node->next = chain->pool;
+        chain->pool = node;
+        chain->pool_count += 1;
+    } else {
+        _chain_destroy_node(node);
+    }
+}
+
 static inline void _chain_destroy_all_nodes(ds_chain_table * chain)
 {
     for (ds_chain_node * next; chain->head; chain->head = next) {
         next = chain->head->next;
-        _chain_destroy_node(chain->head);
+        _chain_recycle_node(chain, chain->head);
     }
     // chain->head is NULL already, now clear chain->tail
     chain->tail = NULL;
+    chain->count = 0;
+}
+
+static inline void _chain_purge_pool(ds_chain_table * chain)
+{
+    for (ds_chain_node * next; chain->pool; chain->pool = next) {
+        next = chain->pool->next;
+        _chain_destroy_node(chain->pool);
+    }
+    chain->pool_count = 0;
 }
 
 #pragma mark -
@@ -54,31 +79,29 @@ ds_chain_table * ds_chain_create(void)
     // create a buffer for the chain struct
     ds_chain_table * chain = (ds_chain_table *)malloc(sizeof(ds_chain_table));
     memset(chain, 0, sizeof(ds_chain_table));
+    chain->pool_capacity = DS_CHAIN_POOL_CAPACITY;
     return chain;
 }
 
 void ds_chain_destroy(ds_chain_table * chain)
 {
     // 1. free child nodes
+    chain->pool_capacity = 0;
     _chain_destroy_all_nodes(chain);
+    _chain_purge_pool(chain);
     
     // 2. free the chain
     free(chain);
 }
 
-ds_size ds_chain_length(const ds_chain_table * chain)
+ds_size (ds_chain_length)(const ds_chain_table * chain)
 {
-    ds_size len = 0;
-    ds_chain_node * node = chain->head;
-    for (; node; node = node->next) {
-        ++len;
-    }
-    return len;
+    return _ds_chain_length(chain);
 }
 
-ds_bool ds_chain_empty(const ds_chain_table * chain)
+ds_bool (ds_chain_empty)(const ds_chain_table * chain)
 {
-    return chain->head == NULL;
+    return _ds_chain_empty(chain);
 }
 
 void ds_chain_clear(ds_chain_table * chain)
@@ -90,23 +113,25 @@ void ds_chain_assign(const ds_chain_table * chain,
                      ds_chain_node * node,
                      const ds_data data, const ds_size data_size)
 {
+    ds_data * dest = ds_chain_node_data(node);
     if (chain->fn.assign) {
-        chain->fn.assign(node->data, data, data_size);
+        chain->fn.assign(dest, data, data_size);
     } else if (chain->bk.assign) {
-        chain->bk.assign(node->data, data, data_size);
+        chain->bk.assign(dest, data, data_size);
     } else {
-        memcpy(node->data, &data, data_size);
+        memcpy(dest, &data, data_size);
     }
 }
 
 void ds_chain_erase(const ds_chain_table * chain, ds_chain_node * node)
 {
+    ds_data * dest = ds_chain_node_data(node);
     if (chain->fn.erase) {
-        chain->fn.erase(node->data, node->data_size);
+        chain->fn.erase(dest, node->data_size);
     } else if (chain->bk.erase) {
-        chain->bk.erase(node->data, node->data_size);
+        chain->bk.erase(dest, node->data_size);
     } else {
-        bzero(node->data, node->data_size);
+        bzero(dest, node->data_size);
     }
 }
 
@@ -127,13 +152,13 @@ ds_chain_node * ds_chain_find(const ds_chain_table * chain, const ds_data data)
     ds_chain_node * node;
     if (chain->fn.compare) {
 	    DS_CHAIN_FOR_EACH_ITEM(chain, node) {
-    	    if (chain->fn.compare(*(node->data), data) == 0) {
+    	    if (chain->fn.compare(*ds_chain_node_data(node), data) == 0) {
 	    	    return node;
     	    }
 	    }
     } else if (chain->bk.compare) {
 	    DS_CHAIN_FOR_EACH_ITEM(chain, node) {
-    	    if (chain->bk.compare(*(node->data), data) == 0) {
+    	    if (chain->bk.compare(*ds_chain_node_data(node), data) == 0) {
 	    	    return node;
     	    }
 	    }
@@ -153,9 +178,11 @@ void ds_chain_insert(ds_chain_table * chain, ds_chain_node * node,
                      const ds_data data, const ds_size data_size)
 {
     // 1. create new node and assign value
-    ds_chain_node * guest = _chain_create_node(data_size);
+    ds_chain_node * guest = _chain_create_node(chain, data_size);
     if (data) {
         ds_chain_assign(chain, guest, data, data_size);
+    } else {
+        bzero(ds_chain_node_data(guest), data_size);
     }
 
     // 2. insert
@@ -173,12 +200,17 @@ void ds_chain_insert(ds_chain_table * chain, ds_chain_node * node,
     if (node == chain->tail) {
         chain->tail = guest;
     }
+    chain->count += 1;
 }
 
 void ds_chain_remove(ds_chain_table * chain, ds_chain_node * node)
 {
     if (node == chain->head) {
         chain->head = node->next;
+        // check tail
+        if (node == chain->tail) {
+            chain->tail = NULL;
+        }
     } else {
         ds_chain_node * prev;
         DS_CHAIN_FOR_EACH_ITEM(chain, prev) {
@@ -194,7 +226,8 @@ void ds_chain_remove(ds_chain_table * chain, ds_chain_node * node)
             chain->tail = prev;
         }
     }
-    _chain_destroy_node(node);
+    chain->count -= 1;
+    _chain_recycle_node(chain, node);
 }
 
 ds_chain_node * ds_chain_shift(ds_chain_table * chain)
@@ -209,6 +242,7 @@ ds_chain_node * ds_chain_shift(ds_chain_table * chain)
         // last node removed
         chain->tail = NULL;
     }
+    chain->count -= 1;
     return first;
 }
 
@@ -217,83 +251,175 @@ void ds_chain_node_destroy(ds_chain_node * node)
     _chain_destroy_node(node);
 }
 
+void ds_chain_node_recycle(ds_chain_table * chain, ds_chain_node * node)
+{
+    _chain_recycle_node(chain, node);
+}
+
+void ds_chain_purge(ds_chain_table * chain)
+{
+    _chain_purge_pool(chain);
+}
+
 #define DS_VALUE(item)     *(item)
 
-#define DS_SWAP(x, y)                                                          \
-        do {                                                                   \
-            memcpy(tmp, (x), data_size);                                       \
-            memcpy((x), (y), data_size);                                       \
-            memcpy((y), tmp, data_size);                                       \
-        } while(0)
+// compare the payloads of two nodes with the chain's function/block
+static inline ds_comparison_result _chain_compare(const ds_chain_table * chain,
+                                                  const ds_chain_node * left,
+                                                  const ds_chain_node * right)
+{
+    if (chain->fn.compare) {
+        return chain->fn.compare(DS_VALUE(ds_chain_node_data(left)),
+                                 DS_VALUE(ds_chain_node_data(right)));
+    } else {
+        return chain->bk.compare(DS_VALUE(ds_chain_node_data(left)),
+                                 DS_VALUE(ds_chain_node_data(right)));
+    }
+}
 
-void ds_chain_sort(ds_chain_table * chain, const ds_size data_size)
+void ds_chain_sort(ds_chain_table * chain)
 {
     if (chain->head == NULL || chain->head->next == NULL) {
 	    // 1. the chain is empty
 	    // 2. the chain has only one node
 	    return;
     }
+    if (chain->fn.compare == NULL && chain->bk.compare == NULL) {
+	    //S9Log(@"cannot sort the chain without comparing function");
+	    return;
+    }
     
     //
-    //  Bubble Sort
+    //  Merge Sort (bottom-up)
     //
-    ds_chain_node * pi = chain->head;
-    ds_chain_node * pj;
-    
-    ds_data * tmp = (ds_data *)malloc(data_size);
+    //      merge each pair of sorted runs (size = 1, 2, 4, ...) by relinking
+    //  the nodes, until there is only one run left; the payloads never move,
+    //  and a node from the left run goes first when they are the same (stable)
+    //
+    ds_chain_node * p, * q, * e, * tail;
+    ds_size size, psize, qsize, merges;
     
-    if (chain->fn.compare) {
-	    for (; pi; pi = pi->next) {
-    	    pj = pi->next;
-    	    for (; pj; pj = pj->next) {
-	    	    if (chain->fn.compare(DS_VALUE(pi->data),
-                                      DS_VALUE(pj->data)) > 0) {
-    	    	    DS_SWAP(pi->data, pj->data);
-	    	    }
+    for (size = 1; ; size *= 2) {
+	    p = chain->head;
+	    chain->head = NULL;
+	    tail = NULL;
+	    merges = 0;
+	    
+	    while (p) {
+    	    ++merges;
+    	    // 1. step 'size' places along from p to get q
+    	    q = p;
+    	    for (psize = 0; psize < size && q; ++psize) {
+	    	    q = q->next;
     	    }
-	    }
-    } else if (chain->bk.compare) {
-	    for (; pi; pi = pi->next) {
-    	    pj = pi->next;
-    	    for (; pj; pj = pj->next) {
-	    	    if (chain->bk.compare(DS_VALUE(pi->data),
-                                      DS_VALUE(pj->data)) > 0) {
-    	    	    DS_SWAP(pi->data, pj->data);
+    	    qsize = size;
+    	    
+    	    // 2. merge run p & run q
+    	    while (psize > 0 || (qsize > 0 && q)) {
+	    	    if (psize == 0) {
+    	    	    e = q; q = q->next; --qsize;
+	    	    } else if (qsize == 0 || q == NULL) {
+    	    	    e = p; p = p->next; --psize;
+	    	    } else if (_chain_compare(chain, p, q) <= 0) {
+    	    	    e = p; p = p->next; --psize;
+	    	    } else {
+    	    	    e = q; q = q->next; --qsize;
+	    	    }
+	    	    // append e to the merged chain
+	    	    if (tail) {
+    	    	    tail->next = e;
+	    	    } else {
+    	    	    chain->head = e;
 	    	    }
+	    	    tail = e;
     	    }
+    	    
+    	    // 3. next pair of runs
+    	    p = q;
+	    }
+	    tail->next = NULL;
+	    
+	    if (merges <= 1) {
+    	    // only one run merged, finished
+    	    break;
 	    }
+    }
+    chain->tail = tail;
+}
+
+void ds_chain_merge(ds_chain_table * chain, ds_chain_table * other)
+{
+    if (other->head == NULL) {
+	    return;
+    }
+    if (chain->fn.compare == NULL && chain->bk.compare == NULL) {
+	    //S9Log(@"cannot merge the chain without comparing function");
+	    return;
+    }
+    
+    ds_chain_node * p = chain->head;
+    ds_chain_node * q = other->head;
+    ds_chain_node * e, * tail = NULL;
+    
+    chain->head = NULL;
+    while (p && q) {
+	    if (_chain_compare(chain, p, q) <= 0) {
+    	    e = p; p = p->next;
+	    } else {
+    	    e = q; q = q->next;
+	    }
+	    if (tail) {
+    	    tail->next = e;
+	    } else {
+    	    chain->head = e;
+	    }
+	    tail = e;
+    }
+    // append the rest run
+    e = p ? p : q;
+    if (tail) {
+	    tail->next = e;
     } else {
-	    //S9Log(@"cannot sort the chain without comparing function");
+	    chain->head = e;
     }
+    if (q) {
+	    // the rest nodes came from the other chain
+	    chain->tail = other->tail;
+    }
+    chain->count += other->count;
     
-    free(tmp);
+    // all nodes moved, now the other chain is empty
+    other->head = NULL;
+    other->tail = NULL;
+    other->count = 0;
 }
 
 void ds_chain_sort_insert(ds_chain_table * chain,
                           const ds_data data, const ds_size data_size)
 {
-    // 1. seek
+    // 1. seek for the last node not bigger than data
+    ds_chain_node * prev = NULL;
     ds_chain_node * node;
     if (chain->fn.compare) {
 	    DS_CHAIN_FOR_EACH_ITEM(chain, node) {
-    	    if (node->next && chain->fn.compare(DS_VALUE(node->next->data),
-                                                data) > 0) {
+    	    if (chain->fn.compare(DS_VALUE(ds_chain_node_data(node)), data) > 0) {
 	    	    break;
     	    }
+    	    prev = node;
 	    }
     } else if (chain->bk.compare) {
 	    DS_CHAIN_FOR_EACH_ITEM(chain, node) {
-    	    if (node->next && chain->bk.compare(DS_VALUE(node->next->data),
-                                                data) > 0) {
+    	    if (chain->bk.compare(DS_VALUE(ds_chain_node_data(node)), data) > 0) {
 	    	    break;
     	    }
+    	    prev = node;
 	    }
     } else {
 	    //S9Log(@"cannot sort the chain without comparing function");
-	    node = chain->tail;
+	    prev = chain->tail;
     }
-    // 2. insert
-    ds_chain_insert(chain, node, data, data_size);
+    // 2. insert after it (or as head node when all items are bigger)
+    ds_chain_insert(chain, prev, data, data_size);
 }
 
 void ds_chain_reverse(ds_chain_table * chain)
@@ -333,7 +459,7 @@ ds_chain_table * ds_chain_copy(const ds_chain_table * chain,
     ds_chain_node * node;
     DS_CHAIN_FOR_EACH_ITEM(chain, node) {
 	    // insert data after the new chain's tail
-        ds_chain_append(new_chain, DS_VALUE(node->data), data_size);
+        ds_chain_append(new_chain, DS_VALUE(ds_chain_node_data(node)), data_size);
     }
     
     return new_chain;
@@ -15,18 +15,34 @@
     for ((node) = (chain)->head; (node); (node) = (node)->next)                \
                                               /* EOF 'DS_CHAIN_FOR_EACH_ITEM' */
 
+//
+//  Notice:
+//      The payload is stored right after the node struct in the same memory
+//      block, so there is no 'data' pointer in the node, please get it with
+//      'ds_chain_node_data(node)'.
+//
 typedef struct _ds_chain_node {
-
-    ds_size data_size; // size of the memory 'ds_chain_node->data' pointed to
-    ds_data * data;
     
     struct _ds_chain_node * next;
+    
+    ds_size data_size; // size of the payload after this node
 } ds_chain_node;
 
+#define ds_chain_node_data(node)  ((ds_data *)((ds_chain_node *)(node) + 1))
+
+// default max count of recycled nodes kept by each chain
+#define DS_CHAIN_POOL_CAPACITY    64
+
 typedef struct _ds_chain_table {
     
     ds_chain_node * head;
     ds_chain_node * tail;
+    ds_size count; // count of nodes from head to tail
+    
+    // recycled nodes, reused by insert before calling malloc
+    ds_chain_node * pool;
+    ds_size pool_count;
+    ds_size pool_capacity; // max count of nodes in the pool (0 to disable)
     
     // functions
     struct {
@@ -118,9 +134,26 @@ ds_chain_node * ds_chain_shift(ds_chain_table * chain);
 void ds_chain_node_destroy(ds_chain_node * node);
 
 /**
- *  sort the chain
+ *  give back the node (removed by 'ds_chain_shift') to the chain's pool,
+ *  it will be reused by next insert, or freed when the pool is full
+ */
+void ds_chain_node_recycle(ds_chain_table * chain, ds_chain_node * node);
+
+/**
+ *  free all recycled nodes in the pool
  */
-void ds_chain_sort(ds_chain_table * chain, const ds_size data_size);
+void ds_chain_purge(ds_chain_table * chain);
+
+/**
+ *  sort the chain (stable merge sort, relinks the nodes without moving data)
+ */
+void ds_chain_sort(ds_chain_table * chain);
+
+/**
+ *  merge all nodes of the other sorted chain into this sorted chain,
+ *  the other chain will be empty after merged
+ */
+void ds_chain_merge(ds_chain_table * chain, ds_chain_table * other);
 
 /**
  *  insert data to the right position to keep the chain sorted
@@ -139,4 +172,21 @@ void ds_chain_reverse(ds_chain_table * chain);
 ds_chain_table * ds_chain_copy(const ds_chain_table * chain,
                                const ds_size data_size);
 
+#pragma mark - Inline accessors
+
+static inline ds_size _ds_chain_length(const ds_chain_table * chain)
+{
+    return chain->count;
+}
+
+static inline ds_bool _ds_chain_empty(const ds_chain_table * chain)
+{
+    return chain->head == NULL;
+}
+
+#if DS_INLINE
+#define ds_chain_length(chain)       _ds_chain_length(chain)
+#define ds_chain_empty(chain)        _ds_chain_empty(chain)
+#endif
+
 #endif /* defined(__ds_chain__) */
@@ -0,0 +1,360 @@
+//
+//  ds_dchain.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_dchain.h"
+
+static inline ds_dchain_node * _dchain_create_node(ds_dchain_table * chain,
+                                                   const ds_size data_size)
+{
+    // 1. reuse a recycled node if it is big enough
+    ds_dchain_node * node = chain->pool;
+    if (node && node->data_size >= data_size) {
+        chain->pool = node->next;
+        chain->pool_count -= 1;
+    } else {
+        // 2. create a buffer for the node struct and the payload after it
+        node = (ds_dchain_node *)malloc(sizeof(ds_dchain_node) + data_size);
+    }
+    node->next = NULL;
+    node->prev = NULL;
+    node->data_size = data_size;
+    return node;
+}
+
+static inline void _dchain_recycle_node(ds_dchain_table * chain, ds_dchain_node * node)
+{
+    if (chain->pool_count < chain->pool_capacity) {
+        node->next = chain->pool;
+        chain->pool = node;
+        chain->pool_count += 1;
+    } else {
+        free(node);
+    }
+}
+
+static inline void _dchain_destroy_all_nodes(ds_dchain_table * chain)
+{
+    for (ds_dchain_node * next; chain->head; chain->head = next) {
+        next = chain->head->next;
+        _dchain_recycle_node(chain, chain->head);
+    }
+    chain->tail = NULL;
+    chain->count = 0;
+}
+
+static inline void _dchain_purge_pool(ds_dchain_table * chain)
+{
+    for (ds_dchain_node * next; chain->pool; chain->pool = next) {
+        next = chain->pool->next;
+        free(chain->pool);
+    }
+    chain->pool_count = 0;
+}
+
+static inline ds_dchain_node * _dchain_new_node(ds_dchain_table * chain,
+                                                const ds_data data,
+                                                const ds_size data_size)
+{
+    ds_dchain_node * guest = _dchain_create_node(chain, data_size);
+    if (data) {
+        ds_dchain_assign(chain, guest, data, data_size);
+    } else {
+        bzero(ds_dchain_node_data(guest), data_size);
+    }
+    return guest;
+}
+
+// link the guest between prev & next
+static inline void _dchain_link(ds_dchain_table * chain, ds_dchain_node * guest,
+                                ds_dchain_node * prev, ds_dchain_node * next)
+{
+    guest->prev = prev;
+    guest->next = next;
+    if (prev) {
+        prev->next = guest;
+    } else {
+        chain->head = guest;
+    }
+    if (next) {
+        next->prev = guest;
+    } else {
+        chain->tail = guest;
+    }
+    chain->count += 1;
+}
+
+static inline void _dchain_unlink(ds_dchain_table * chain, ds_dchain_node * node)
+{
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        chain->head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        chain->tail = node->prev;
+    }
+    node->next = NULL;
+    node->prev = NULL;
+    chain->count -= 1;
+}
+
+#pragma mark -
+
+ds_dchain_table * ds_dchain_create(void)
+{
+    ds_dchain_table * chain = (ds_dchain_table *)malloc(sizeof(ds_dchain_table));
+    memset(chain, 0, sizeof(ds_dchain_table));
+    chain->pool_capacity = DS_DCHAIN_POOL_CAPACITY;
+    return chain;
+}
+
+void ds_dchain_destroy(ds_dchain_table * chain)
+{
+    // 1. free child nodes
+    chain->pool_capacity = 0;
+    _dchain_destroy_all_nodes(chain);
+    _dchain_purge_pool(chain);
+
+    // 2. free the chain
+    free(chain);
+}
+
+ds_size (ds_dchain_length)(const ds_dchain_table * chain)
+{
+    return _ds_dchain_length(chain);
+}
+
+ds_bool (ds_dchain_empty)(const ds_dchain_table * chain)
+{
+    return _ds_dchain_empty(chain);
+}
+
+void ds_dchain_clear(ds_dchain_table * chain)
+{
+    _dchain_destroy_all_nodes(chain);
+}
+
+void ds_dchain_assign(const ds_dchain_table * chain,
+                      ds_dchain_node * node,
+                      const ds_data data, const ds_size data_size)
+{
+    ds_data * dest = ds_dchain_node_data(node);
+    if (chain->fn.assign) {
+        chain->fn.assign(dest, data, data_size);
+    } else if (chain->bk.assign) {
+        chain->bk.assign(dest, data, data_size);
+    } else {
+        memcpy(dest, &data, data_size);
+    }
+}
+
+void ds_dchain_erase(const ds_dchain_table * chain, ds_dchain_node * node)
+{
+    ds_data * dest = ds_dchain_node_data(node);
+    if (chain->fn.erase) {
+        chain->fn.erase(dest, node->data_size);
+    } else if (chain->bk.erase) {
+        chain->bk.erase(dest, node->data_size);
+    } else {
+        bzero(dest, node->data_size);
+    }
+}
+
+ds_dchain_node * ds_dchain_at(const ds_dchain_table * chain, ds_size index)
+{
+    if (index < 0 || index >= chain->count) {
+        return NULL;
+    }
+    ds_dchain_node * node;
+    if (index < chain->count / 2) {
+        // seeking from head
+        DS_DCHAIN_FOR_EACH_ITEM(chain, node) {
+            if (index == 0) {
+                break;
+            }
+            --index;
+        }
+    } else {
+        // seeking from tail
+        index = chain->count - 1 - index;
+        DS_DCHAIN_FOR_EACH_ITEM_REVERSE(chain, node) {
+            if (index == 0) {
+                break;
+            }
+            --index;
+        }
+    }
+    return node;
+}
+
+ds_dchain_node * ds_dchain_find(const ds_dchain_table * chain, const ds_data data)
+{
+    ds_dchain_node * node;
+    if (chain->fn.compare) {
+        DS_DCHAIN_FOR_EACH_ITEM(chain, node) {
+            if (chain->fn.compare(*ds_dchain_node_data(node), data) == 0) {
+                return node;
+            }
+        }
+    } else if (chain->bk.compare) {
+        DS_DCHAIN_FOR_EACH_ITEM(chain, node) {
+            if (chain->bk.compare(*ds_dchain_node_data(node), data) == 0) {
+                return node;
+            }
+        }
+    } else {
+        //S9Log(@"cannot search the chain without comparing function");
+    }
+    return NULL;
+}
+
+ds_dchain_node * ds_dchain_append(ds_dchain_table * chain,
+                                  const ds_data data, const ds_size data_size)
+{
+    return ds_dchain_insert(chain, chain->tail, data, data_size);
+}
+
+ds_dchain_node * ds_dchain_insert(ds_dchain_table * chain, ds_dchain_node * node,
+                                  const ds_data data, const ds_size data_size)
+{
+    ds_dchain_node * guest = _dchain_new_node(chain, data, data_size);
+    if (node) {
+        // after the node
+        _dchain_link(chain, guest, node, node->next);
+    } else {
+        // as head node
+        _dchain_link(chain, guest, NULL, chain->head);
+    }
+    return guest;
+}
+
+ds_dchain_node * ds_dchain_insert_before(ds_dchain_table * chain, ds_dchain_node * node,
+                                         const ds_data data, const ds_size data_size)
+{
+    ds_dchain_node * guest = _dchain_new_node(chain, data, data_size);
+    if (node) {
+        // before the node
+        _dchain_link(chain, guest, node->prev, node);
+    } else {
+        // as tail node
+        _dchain_link(chain, guest, chain->tail, NULL);
+    }
+    return guest;
+}
+
+void ds_dchain_remove(ds_dchain_table * chain, ds_dchain_node * node)
+{
+    _dchain_unlink(chain, node);
+    _dchain_recycle_node(chain, node);
+}
+
+ds_dchain_node * ds_dchain_shift(ds_dchain_table * chain)
+{
+    ds_dchain_node * first = chain->head;
+    if (first) {
+        _dchain_unlink(chain, first);
+    }
+    return first;
+}
+
+ds_dchain_node * ds_dchain_pop(ds_dchain_table * chain)
+{
+    ds_dchain_node * last = chain->tail;
+    if (last) {
+        _dchain_unlink(chain, last);
+    }
+    return last;
+}
+
+void ds_dchain_node_destroy(ds_dchain_node * node)
+{
+    free(node);
+}
+
+void ds_dchain_node_recycle(ds_dchain_table * chain, ds_dchain_node * node)
+{
+    _dchain_recycle_node(chain, node);
+}
+
+void ds_dchain_purge(ds_dchain_table * chain)
+{
+    _dchain_purge_pool(chain);
+}
+
+ds_dchain_node * ds_dchain_sort_insert(ds_dchain_table * chain,
+                                       const ds_data data, const ds_size data_size)
+{
+    // 1. seek from tail for the last node not bigger than data,
+    //    so the new item will be placed after the same values
+    ds_dchain_node * node;
+    if (chain->fn.compare) {
+        DS_DCHAIN_FOR_EACH_ITEM_REVERSE(chain, node) {
+            if (chain->fn.compare(*ds_dchain_node_data(node), data) <= 0) {
+                break;
+            }
+        }
+    } else if (chain->bk.compare) {
+        DS_DCHAIN_FOR_EACH_ITEM_REVERSE(chain, node) {
+            if (chain->bk.compare(*ds_dchain_node_data(node), data) <= 0) {
+                break;
+            }
+        }
+    } else {
+        //S9Log(@"cannot sort the chain without comparing function");
+        node = chain->tail;
+    }
+    // 2. insert after it (or as head when all items are bigger)
+    return ds_dchain_insert(chain, node, data, data_size);
+}
+
+void ds_dchain_reverse(ds_dchain_table * chain)
+{
+    ds_dchain_node * node = chain->head;
+    ds_dchain_node * next;
+    for (; node; node = next) {
+        next = node->next;
+        node->next = node->prev;
+        node->prev = next;
+    }
+    // swap head & tail
+    node = chain->tail;
+    chain->tail = chain->head;
+    chain->head = node;
+}
+
+ds_dchain_table * ds_dchain_copy(const ds_dchain_table * chain)
+{
+    ds_dchain_table * new_chain = ds_dchain_create();
+
+    new_chain->fn.assign  = chain->fn.assign;
+    new_chain->fn.erase   = chain->fn.erase;
+    new_chain->fn.compare = chain->fn.compare;
+    new_chain->bk.assign  = chain->bk.assign;
+    new_chain->bk.erase   = chain->bk.erase;
+    new_chain->bk.compare = chain->bk.compare;
+
+    ds_dchain_node * node;
+    ds_dchain_node * guest;
+    DS_DCHAIN_FOR_EACH_ITEM(chain, node) {
+        // insert data after the new chain's tail
+        guest = _dchain_create_node(new_chain, node->data_size);
+        if (chain->fn.assign || chain->bk.assign) {
+            ds_dchain_assign(new_chain, guest, *ds_dchain_node_data(node), node->data_size);
+        } else {
+            memcpy(ds_dchain_node_data(guest), ds_dchain_node_data(node), node->data_size);
+        }
+        _dchain_link(new_chain, guest, new_chain->tail, NULL);
+    }
+
+    return new_chain;
+}
@@ -0,0 +1,198 @@
+//
+//  ds_dchain.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_dchain__
+#define __ds_dchain__
+
+#include "ds_base.h"
+
+//
+//  Doubly-linked chain table
+//
+//      Same as 'ds_chain_table', but each node also links to the previous one,
+//  so a node can be removed (or inserted before) in O(1) time, and the chain
+//  can be enumerated in reverse order.
+//
+
+#define DS_DCHAIN_FOR_EACH_ITEM(chain, node)                                   \
+    for ((node) = (chain)->head; (node); (node) = (node)->next)                \
+                                             /* EOF 'DS_DCHAIN_FOR_EACH_ITEM' */
+
+#define DS_DCHAIN_FOR_EACH_ITEM_REVERSE(chain, node)                           \
+    for ((node) = (chain)->tail; (node); (node) = (node)->prev)                \
+                                     /* EOF 'DS_DCHAIN_FOR_EACH_ITEM_REVERSE' */
+
+typedef struct _ds_dchain_node {
+
+    struct _ds_dchain_node * next;
+    struct _ds_dchain_node * prev;
+
+    ds_size data_size; // size of the payload after this node
+} ds_dchain_node;
+
+#define ds_dchain_node_data(node) ((ds_data *)((ds_dchain_node *)(node) + 1))
+
+// default max count of recycled nodes kept by each chain
+#define DS_DCHAIN_POOL_CAPACITY   64
+
+typedef struct _ds_dchain_table {
+
+    ds_dchain_node * head;
+    ds_dchain_node * tail;
+    ds_size count; // count of nodes from head to tail
+
+    // recycled nodes, reused by insert before calling malloc
+    ds_dchain_node * pool;
+    ds_size pool_count;
+    ds_size pool_capacity; // max count of nodes in the pool (0 to disable)
+
+    // functions
+    struct {
+	    ds_assign_func   assign;
+	    ds_erase_func    erase;
+	    ds_compare_func  compare;
+    } fn;
+    // blocks
+    struct {
+	    ds_assign_block  assign;
+	    ds_erase_block   erase;
+	    ds_compare_block compare;
+    } bk;
+} ds_dchain_table;
+
+/**
+ *  create a doubly-linked chain table
+ */
+ds_dchain_table * ds_dchain_create(void);
+
+/**
+ *  destroy the chain table and its child nodes
+ */
+void ds_dchain_destroy(ds_dchain_table * chain);
+
+/**
+ *  get chain->count
+ */
+ds_size ds_dchain_length(const ds_dchain_table * chain);
+
+/**
+ *  check chain->head == NULL
+ */
+ds_bool ds_dchain_empty(const ds_dchain_table * chain);
+
+/**
+ *  remove all nodes
+ */
+void ds_dchain_clear(ds_dchain_table * chain);
+
+/**
+ *  assign data to the node (data should not be NULL)
+ */
+void ds_dchain_assign(const ds_dchain_table * chain,
+                      ds_dchain_node * node,
+                      const ds_data data, const ds_size data_size);
+
+/**
+ *  erase data in the node
+ */
+void ds_dchain_erase(const ds_dchain_table * chain, ds_dchain_node * node);
+
+/**
+ *  get node at index of the chain (seeking from the nearer end)
+ */
+ds_dchain_node * ds_dchain_at(const ds_dchain_table * chain, const ds_size index);
+
+/**
+ *  get first node has the same data value
+ */
+ds_dchain_node * ds_dchain_find(const ds_dchain_table * chain, const ds_data data);
+
+/**
+ *  append data to the tail
+ */
+ds_dchain_node * ds_dchain_append(ds_dchain_table * chain,
+                                  const ds_data data, const ds_size data_size);
+
+/**
+ *  insert data after the node, if (node == NULL) then insert as head node
+ */
+ds_dchain_node * ds_dchain_insert(ds_dchain_table * chain, ds_dchain_node * node,
+                                  const ds_data data, const ds_size data_size);
+
+/**
+ *  insert data before the node, if (node == NULL) then insert as tail node
+ */
+ds_dchain_node * ds_dchain_insert_before(ds_dchain_table * chain, ds_dchain_node * node,
+                                         const ds_data data, const ds_size data_size);
+
+/**
+ *  remove the chain node in O(1)
+ */
+void ds_dchain_remove(ds_dchain_table * chain, ds_dchain_node * node);
+
+/**
+ *  remove head item from the chain and return it,
+ *  this node will no longer retain by the chain, so you should destroy it manually
+ */
+ds_dchain_node * ds_dchain_shift(ds_dchain_table * chain);
+
+/**
+ *  remove tail item from the chain and return it,
+ *  this node will no longer retain by the chain, so you should destroy it manually
+ */
+ds_dchain_node * ds_dchain_pop(ds_dchain_table * chain);
+
+/**
+ *  destroy the node (this node must be removed from the chain already)
+ */
+void ds_dchain_node_destroy(ds_dchain_node * node);
+
+/**
+ *  give back the node (removed from the chain already) to the chain's pool
+ */
+void ds_dchain_node_recycle(ds_dchain_table * chain, ds_dchain_node * node);
+
+/**
+ *  free all recycled nodes in the pool
+ */
+void ds_dchain_purge(ds_dchain_table * chain);
+
+/**
+ *  insert data to the right position to keep the chain sorted
+ */
+ds_dchain_node * ds_dchain_sort_insert(ds_dchain_table * chain,
+                                       const ds_data data, const ds_size data_size);
+
+/**
+ *  reverse the chain
+ */
+void ds_dchain_reverse(ds_dchain_table * chain);
+
+/**
+ *  copy chain
+ */
+ds_dchain_table * ds_dchain_copy(const ds_dchain_table * chain);
+
+#pragma mark - Inline accessors
+
+static inline ds_size _ds_dchain_length(const ds_dchain_table * chain)
+{
+    return chain->count;
+}
+
+static inline ds_bool _ds_dchain_empty(const ds_dchain_table * chain)
+{
+    return chain->head == NULL;
+}
+
+#if DS_INLINE
+#define ds_dchain_length(chain)      _ds_dchain_length(chain)
+#define ds_dchain_empty(chain)       _ds_dchain_empty(chain)
+#endif
+
+#endif /* defined(__ds_dchain__) */
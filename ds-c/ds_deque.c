@@ -0,0 +1,254 @@
+//
+//  ds_deque.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_deque.h"
+
+#define _deque_offset(deque, pos)  ((pos) & ((deque)->capacity - 1))
+
+#define _deque_ptr(deque, pos)                                                 \
+            ((ds_data *)((ds_byte *)(deque)->items +                           \
+                         _deque_offset(deque, pos) * (deque)->item_size))
+
+static inline void _deque_assign(const ds_deque * deque,
+                                 ds_data * dest, const ds_data src)
+{
+    if (deque->fn.assign) {
+	    deque->fn.assign(dest, src, deque->item_size);
+    } else if (deque->bk.assign) {
+	    deque->bk.assign(dest, src, deque->item_size);
+    } else {
+	    memcpy(dest, &src, deque->item_size);
+    }
+}
+
+static inline void _deque_expand(ds_deque * deque)
+{
+    ds_size middle = deque->capacity;
+    ds_size head = _deque_offset(deque, deque->head);
+    ds_size count = ds_deque_length(deque);
+    deque->capacity *= 2;
+    deque->items = (ds_data *)realloc(deque->items, deque->capacity * deque->item_size);
+
+    // rebase the counters to the head offset, so items [head, middle) stay,
+    // and the wrapped part [0, head + count - middle) moves to the new zone
+    if (head + count > middle) {
+	    ds_byte * src = (ds_byte *)deque->items;
+	    ds_byte * dest = src + middle * deque->item_size;
+	    memcpy(dest, src, (head + count - middle) * deque->item_size);
+    }
+    deque->head = head;
+    deque->tail = head + count;
+}
+
+static inline void _deque_reserve(ds_deque * deque, const ds_size count)
+{
+    while (deque->capacity - ds_deque_length(deque) < count) {
+        _deque_expand(deque);
+    }
+}
+
+// copy items into the buffer from counter 'pos', at most two parts
+static inline void _deque_copy_in(ds_deque * deque, const unsigned int pos,
+                                  const ds_data * items, const ds_size count)
+{
+    ds_size offset = _deque_offset(deque, pos);
+    ds_size part1 = deque->capacity - offset;
+    if (part1 > count) {
+        part1 = count;
+    }
+    ds_byte * dest = (ds_byte *)deque->items;
+    memcpy(dest + offset * deque->item_size, items, part1 * deque->item_size);
+    if (part1 < count) {
+        // wrapped
+        memcpy(dest, (ds_byte *)items + part1 * deque->item_size,
+               (count - part1) * deque->item_size);
+    }
+}
+
+// copy items out of the buffer from counter 'pos', at most two parts
+static inline void _deque_copy_out(const ds_deque * deque, const unsigned int pos,
+                                   ds_data * items, const ds_size count)
+{
+    ds_size offset = _deque_offset(deque, pos);
+    ds_size part1 = deque->capacity - offset;
+    if (part1 > count) {
+        part1 = count;
+    }
+    ds_byte * src = (ds_byte *)deque->items;
+    memcpy(items, src + offset * deque->item_size, part1 * deque->item_size);
+    if (part1 < count) {
+        // wrapped
+        memcpy((ds_byte *)items + part1 * deque->item_size, src,
+               (count - part1) * deque->item_size);
+    }
+}
+
+#pragma mark -
+
+ds_deque * ds_deque_create(const ds_size item_size, const ds_size capacity)
+{
+    ds_deque * deque = (ds_deque *)malloc(sizeof(ds_deque));
+    memset(deque, 0, sizeof(ds_deque));
+    ds_size size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    deque->capacity = capacity > 0 ? size : 8;
+    deque->item_size = item_size > 0 ? item_size : (ds_size)sizeof(ds_data);
+    deque->items = (ds_data *)calloc(deque->capacity, deque->item_size);
+    return deque;
+}
+
+void ds_deque_destroy(ds_deque * deque)
+{
+    free(deque->items);
+    deque->items = NULL;
+    free(deque);
+}
+
+ds_size (ds_deque_length)(const ds_deque * deque)
+{
+    return _ds_deque_length(deque);
+}
+
+ds_bool (ds_deque_empty)(const ds_deque * deque)
+{
+    return _ds_deque_empty(deque);
+}
+
+ds_data * (ds_deque_at)(const ds_deque * deque, const ds_size index)
+{
+    return _ds_deque_at(deque, index);
+}
+
+void ds_deque_clear(ds_deque * deque)
+{
+    deque->head = 0;
+    deque->tail = 0;
+}
+
+void ds_deque_push_front(ds_deque * deque, const ds_data item)
+{
+    if (ds_deque_length(deque) == deque->capacity) {
+        _deque_expand(deque);
+    }
+    deque->head -= 1;
+    _deque_assign(deque, _deque_ptr(deque, deque->head), item);
+}
+
+void ds_deque_push_back(ds_deque * deque, const ds_data item)
+{
+    if (ds_deque_length(deque) == deque->capacity) {
+        _deque_expand(deque);
+    }
+    _deque_assign(deque, _deque_ptr(deque, deque->tail), item);
+    deque->tail += 1;
+}
+
+ds_data * ds_deque_pop_front(ds_deque * deque)
+{
+    if (deque->head == deque->tail) {
+        // empty deque
+        return NULL;
+    }
+    ds_data * item = _deque_ptr(deque, deque->head);
+    deque->head += 1;
+    return item;
+}
+
+ds_data * ds_deque_pop_back(ds_deque * deque)
+{
+    if (deque->head == deque->tail) {
+        // empty deque
+        return NULL;
+    }
+    deque->tail -= 1;
+    return _deque_ptr(deque, deque->tail);
+}
+
+ds_data * ds_deque_front(const ds_deque * deque)
+{
+    return deque->head == deque->tail ? NULL : _deque_ptr(deque, deque->head);
+}
+
+ds_data * ds_deque_back(const ds_deque * deque)
+{
+    return deque->head == deque->tail ? NULL : _deque_ptr(deque, deque->tail - 1);
+}
+
+#pragma mark Bulk
+
+void ds_deque_push_front_n(ds_deque * deque, const ds_data * items, const ds_size count)
+{
+    if (count <= 0) {
+        return;
+    }
+    _deque_reserve(deque, count);
+    deque->head -= count;
+    _deque_copy_in(deque, deque->head, items, count);
+}
+
+void ds_deque_push_back_n(ds_deque * deque, const ds_data * items, const ds_size count)
+{
+    if (count <= 0) {
+        return;
+    }
+    _deque_reserve(deque, count);
+    _deque_copy_in(deque, deque->tail, items, count);
+    deque->tail += count;
+}
+
+ds_size ds_deque_pop_front_n(ds_deque * deque, ds_data * items, const ds_size max)
+{
+    ds_size count = ds_deque_length(deque);
+    if (count > max) {
+        count = max;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+    if (items) {
+        _deque_copy_out(deque, deque->head, items, count);
+    }
+    deque->head += count;
+    return count;
+}
+
+ds_size ds_deque_pop_back_n(ds_deque * deque, ds_data * items, const ds_size max)
+{
+    ds_size count = ds_deque_length(deque);
+    if (count > max) {
+        count = max;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+    deque->tail -= count;
+    if (items) {
+        _deque_copy_out(deque, deque->tail, items, count);
+    }
+    return count;
+}
+
+ds_deque * ds_deque_copy(const ds_deque * deque)
+{
+    ds_size count = ds_deque_length(deque);
+    ds_deque * new_deque = ds_deque_create(deque->item_size, count);
+
+    new_deque->fn.assign = deque->fn.assign;
+    new_deque->fn.erase  = deque->fn.erase;
+    new_deque->bk.assign = deque->bk.assign;
+    new_deque->bk.erase  = deque->bk.erase;
+
+    _deque_copy_out(deque, deque->head, new_deque->items, count);
+    new_deque->tail = count;
+    return new_deque;
+}
@@ -0,0 +1,184 @@
+//
+//  ds_deque.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_deque__
+#define __ds_deque__
+
+#include "ds_base.h"
+
+//
+//  Double-ended queue
+//
+//      Items are stored in one circular buffer like 'ds_circular_queue' (in
+//  masked mode): the capacity is a power of two, head/tail are free-running
+//  counters masked when accessing, so pushing/popping at both ends are O(1),
+//  and no node allocation is needed.
+//
+
+#define DS_DEQUE_FOR_EACH_ITEM(deque, item, index)                             \
+    for ((index) = 0;                                                          \
+         (item) = (__typeof__(item))ds_deque_at(deque, index),                 \
+             (index) < ds_deque_length(deque);                                 \
+         ++(index))                                                            \
+                                              /* EOF 'DS_DEQUE_FOR_EACH_ITEM' */
+
+#define DS_DEQUE_FOR_EACH_ITEM_REVERSE(deque, item, index)                     \
+    for ((index) = ds_deque_length(deque);                                     \
+         (item) = (__typeof__(item))ds_deque_at(deque, (index) - 1),           \
+             (index)-- > 0;                                                    \
+         )                                                                     \
+                                      /* EOF 'DS_DEQUE_FOR_EACH_ITEM_REVERSE' */
+
+typedef struct _ds_deque {
+
+    ds_size capacity; // power of two
+    unsigned int head, tail; // counters of head/tail
+
+    ds_size item_size;
+    ds_data * items;
+
+    // functions
+    struct {
+	    ds_assign_func   assign;
+	    ds_erase_func    erase;
+    } fn;
+    // blocks
+    struct {
+	    ds_assign_block  assign;
+	    ds_erase_block   erase;
+    } bk;
+} ds_deque;
+
+typedef ds_data         ds_deque_node;
+
+/**
+ *  create a deque with item size and capacity (rounded up to power of two)
+ */
+ds_deque * ds_deque_create(const ds_size item_size, const ds_size capacity);
+
+/**
+ *  destroy the deque struct and its items
+ */
+void ds_deque_destroy(ds_deque * deque);
+
+/**
+ *  get items count
+ */
+ds_size ds_deque_length(const ds_deque * deque);
+
+/**
+ *  check deque->tail == deque->head
+ */
+ds_bool ds_deque_empty(const ds_deque * deque);
+
+/**
+ *  get item at the position from head (0 <= index < length)
+ */
+ds_data * ds_deque_at(const ds_deque * deque, const ds_size index);
+
+/**
+ *  set deque->head = 0; deque->tail = 0;
+ */
+void ds_deque_clear(ds_deque * deque);
+
+/**
+ *  insert the item before head of the deque
+ */
+void ds_deque_push_front(ds_deque * deque, const ds_data item);
+
+/**
+ *  append the item after tail of the deque
+ */
+void ds_deque_push_back(ds_deque * deque, const ds_data item);
+
+/**
+ *  remove head item and return it (but NOT erase), or NULL when empty;
+ *  the item is valid until next push
+ */
+ds_deque_node * ds_deque_pop_front(ds_deque * deque);
+
+/**
+ *  remove tail item and return it (but NOT erase), or NULL when empty;
+ *  the item is valid until next push
+ */
+ds_deque_node * ds_deque_pop_back(ds_deque * deque);
+
+/**
+ *  get head item (not removed), or NULL when empty
+ */
+ds_deque_node * ds_deque_front(const ds_deque * deque);
+
+/**
+ *  get tail item (not removed), or NULL when empty
+ */
+ds_deque_node * ds_deque_back(const ds_deque * deque);
+
+#pragma mark Bulk
+
+//
+//      The bulk operations copy raw items (item_size bytes for each) by at most
+//  two memcpy around the end of buffer, the assign hooks are not called.
+//
+
+/**
+ *  insert items before head, keeping their order (items[0] will be the head)
+ */
+void ds_deque_push_front_n(ds_deque * deque, const ds_data * items, const ds_size count);
+
+/**
+ *  append items after tail
+ */
+void ds_deque_push_back_n(ds_deque * deque, const ds_data * items, const ds_size count);
+
+/**
+ *  remove at most 'max' items from head, copy them into 'items' by order,
+ *  or just drop them if 'items' is NULL
+ *
+ * @return count of removed items
+ */
+ds_size ds_deque_pop_front_n(ds_deque * deque, ds_data * items, const ds_size max);
+
+/**
+ *  remove at most 'max' items from tail, copy them into 'items' by order
+ *  (the last one is the old tail), or just drop them if 'items' is NULL
+ *
+ * @return count of removed items
+ */
+ds_size ds_deque_pop_back_n(ds_deque * deque, ds_data * items, const ds_size max);
+
+/**
+ *  copy the deque
+ */
+ds_deque * ds_deque_copy(const ds_deque * deque);
+
+#pragma mark - Inline accessors
+
+static inline ds_size _ds_deque_length(const ds_deque * deque)
+{
+    return (ds_size)(deque->tail - deque->head);
+}
+
+static inline ds_bool _ds_deque_empty(const ds_deque * deque)
+{
+    return deque->tail == deque->head;
+}
+
+static inline ds_data * _ds_deque_at(const ds_deque * deque, const ds_size index)
+{
+    //assert(0 <= index && index < _ds_deque_length(deque));
+    ds_byte * ptr = (ds_byte *)deque->items;
+    return (ds_data *)(ptr + ((deque->head + index) & (deque->capacity - 1)) * deque->item_size);
+}
+
+#if DS_INLINE
+#define ds_deque_length(deque)       _ds_deque_length(deque)
+#define ds_deque_empty(deque)        _ds_deque_empty(deque)
+#define ds_deque_at(deque, index)    _ds_deque_at(deque, index)
+#endif
+
+#endif /* defined(__ds_deque__) */
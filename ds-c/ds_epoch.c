@@ -0,0 +1,208 @@
+//
+//  ds_epoch.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "ds_epoch.h"
+
+#define DS_EPOCH_ACTIVE       1
+
+static inline ds_size _epoch_bag_free(ds_epoch_bag * bag)
+{
+    ds_size count = bag->count;
+    ds_epoch_garbage * item;
+    for (ds_size index = 0; index < count; ++index) {
+        item = bag->items + index;
+        if (item->func) {
+            item->func(item->ptr);
+        } else {
+            free(item->ptr);
+        }
+    }
+    bag->count = 0;
+    return count;
+}
+
+// free the bags retired two epochs ago (or earlier)
+static inline ds_size _epoch_free_expired(ds_epoch_record * record, const unsigned int epoch)
+{
+    ds_size count = 0;
+    ds_epoch_bag * bag;
+    for (int index = 0; index < 3; ++index) {
+        bag = record->bags + index;
+        if (bag->count > 0 && (int)(epoch - bag->epoch) >= 2) {
+            count += _epoch_bag_free(bag);
+        }
+    }
+    record->pending -= count;
+    return count;
+}
+
+// advance the global epoch if all active records have seen it
+static inline unsigned int _epoch_try_advance(ds_epoch_domain * domain)
+{
+    unsigned int epoch = atomic_load(&domain->epoch);
+    unsigned int seen = (epoch << 1) | DS_EPOCH_ACTIVE;
+    unsigned int local;
+    ds_epoch_record * record = atomic_load_explicit(&domain->records, memory_order_acquire);
+    for (; record; record = record->next) {
+        local = atomic_load(&record->epoch);
+        if ((local & DS_EPOCH_ACTIVE) && local != seen) {
+            // still reading in the previous epoch
+            return epoch;
+        }
+    }
+    if (atomic_compare_exchange_strong(&domain->epoch, &epoch, epoch + 1)) {
+        return epoch + 1;
+    }
+    return epoch; // advanced by other thread
+}
+
+#pragma mark -
+
+ds_epoch_domain * ds_epoch_create(void)
+{
+    // aligned to cache line for the padded words
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_epoch_domain)) != 0) {
+        return NULL;
+    }
+    ds_epoch_domain * domain = (ds_epoch_domain *)ptr;
+    memset(domain, 0, sizeof(ds_epoch_domain));
+    atomic_init(&domain->epoch, 0);
+    atomic_init(&domain->records, NULL);
+    return domain;
+}
+
+void ds_epoch_destroy(ds_epoch_domain * domain)
+{
+    ds_epoch_record * record = atomic_load(&domain->records);
+    ds_epoch_record * next;
+    for (; record; record = next) {
+        next = record->next;
+        for (int index = 0; index < 3; ++index) {
+            _epoch_bag_free(record->bags + index);
+            free(record->bags[index].items);
+        }
+        free(record);
+    }
+    free(domain);
+}
+
+ds_epoch_record * ds_epoch_register(ds_epoch_domain * domain)
+{
+    // 1. reuse a record given back
+    ds_epoch_record * record = atomic_load_explicit(&domain->records, memory_order_acquire);
+    int idle;
+    for (; record; record = record->next) {
+        idle = 0;
+        if (atomic_load_explicit(&record->in_use, memory_order_relaxed) == 0 &&
+            atomic_compare_exchange_strong(&record->in_use, &idle, 1)) {
+            return record;
+        }
+    }
+    // 2. create a new record, and push it into the list
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_epoch_record)) != 0) {
+        return NULL;
+    }
+    record = (ds_epoch_record *)ptr;
+    memset(record, 0, sizeof(ds_epoch_record));
+    atomic_init(&record->epoch, 0);
+    atomic_init(&record->in_use, 1);
+    ds_epoch_record * head = atomic_load(&domain->records);
+    do {
+        record->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&domain->records, &head, record,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+    return record;
+}
+
+void ds_epoch_unregister(ds_epoch_domain * domain, ds_epoch_record * record)
+{
+    //assert(record->nesting == 0);
+    ds_epoch_collect(domain, record);
+    atomic_store_explicit(&record->in_use, 0, memory_order_release);
+}
+
+void ds_epoch_enter(ds_epoch_domain * domain, ds_epoch_record * record)
+{
+    if (record->nesting++ > 0) {
+        return;
+    }
+    unsigned int epoch = atomic_load(&domain->epoch);
+    for (;;) {
+        atomic_store_explicit(&record->epoch, (epoch << 1) | DS_EPOCH_ACTIVE,
+                              memory_order_relaxed);
+        // publish the record before reading any shared pointer
+        atomic_thread_fence(memory_order_seq_cst);
+        unsigned int current = atomic_load(&domain->epoch);
+        if (current == epoch) {
+            break;
+        }
+        // advanced before published, see it again
+        epoch = current;
+    }
+}
+
+void ds_epoch_leave(ds_epoch_domain * domain, ds_epoch_record * record)
+{
+    (void)domain;
+    //assert(record->nesting > 0);
+    if (--record->nesting > 0) {
+        return;
+    }
+    atomic_store_explicit(&record->epoch, 0, memory_order_release);
+}
+
+void ds_epoch_retire(ds_epoch_domain * domain, ds_epoch_record * record,
+                     void * ptr, ds_epoch_free_func func)
+{
+    unsigned int epoch = atomic_load(&domain->epoch);
+    ds_epoch_bag * bag = record->bags + epoch % 3;
+    if (bag->epoch != epoch) {
+        // the bag was retired three epochs ago, safe to free
+        record->pending -= _epoch_bag_free(bag);
+        bag->epoch = epoch;
+    }
+    if (bag->count == bag->capacity) {
+        bag->capacity = bag->capacity > 0 ? bag->capacity * 2 : DS_EPOCH_BATCH_SIZE;
+        bag->items = (ds_epoch_garbage *)realloc(bag->items,
+                                                 bag->capacity * sizeof(ds_epoch_garbage));
+    }
+    bag->items[bag->count].ptr = ptr;
+    bag->items[bag->count].func = func;
+    bag->count += 1;
+    record->pending += 1;
+    if (record->pending >= DS_EPOCH_BATCH_SIZE) {
+        ds_epoch_collect(domain, record);
+    }
+}
+
+ds_size ds_epoch_collect(ds_epoch_domain * domain, ds_epoch_record * record)
+{
+    if (record->pending == 0) {
+        return 0;
+    }
+    unsigned int epoch = _epoch_try_advance(domain);
+    return _epoch_free_expired(record, epoch);
+}
+
+void ds_epoch_barrier(ds_epoch_domain * domain, ds_epoch_record * record)
+{
+    //assert(record->nesting == 0);
+    while (record->pending > 0) {
+        if (ds_epoch_collect(domain, record) == 0) {
+            // waiting for other readers
+            sched_yield();
+        }
+    }
+}
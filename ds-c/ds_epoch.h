@@ -0,0 +1,131 @@
+//
+//  ds_epoch.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_epoch__
+#define __ds_epoch__
+
+#include <stdatomic.h>
+
+#include "ds_base.h"
+
+//
+//  Epoch-based reclamation
+//
+//      Readers traverse shared chains/arrays between 'enter' and 'leave' with
+//  no lock or reference counting, they just publish the global epoch they
+//  saw in their own records; writers unlink the memory first, then 'retire'
+//  it into the deferred list of the current epoch. The global epoch can only
+//  advance when all active readers have seen it, so after two advances no
+//  reader can still hold a pointer retired before, and the list is freed.
+//
+//      Each thread registers a record in the domain (records are reused after
+//  unregistering); the deferred lists are kept in the records and collected
+//  in batches, when 'DS_EPOCH_BATCH_SIZE' pointers are waiting.
+//
+//  Usage:
+//      record = ds_epoch_register(domain);
+//      // reader
+//      ds_epoch_enter(domain, record);
+//      ... read the shared chain ...
+//      ds_epoch_leave(domain, record);
+//      // writer
+//      node = ds_chain_shift(chain); // unlinked, not freed
+//      ds_epoch_retire(domain, record, node,
+//                      (ds_epoch_free_func)ds_chain_node_destroy);
+//
+
+#define DS_EPOCH_BATCH_SIZE   64
+
+// function to free the retired memory (NULL for 'free')
+typedef void (*ds_epoch_free_func)(void * ptr);
+
+typedef struct _ds_epoch_garbage {
+    void * ptr;
+    ds_epoch_free_func func;
+} ds_epoch_garbage;
+
+typedef struct _ds_epoch_bag {
+    unsigned int epoch; // when retired
+    ds_size capacity;
+    ds_size count;
+    ds_epoch_garbage * items;
+} ds_epoch_bag;
+
+typedef struct _ds_epoch_record {
+
+    // (global epoch << 1) | 1 when active, 0 when not
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_uint epoch;
+
+    // owner thread only
+    ds_size nesting;
+    ds_size pending; // count of retired pointers
+    ds_epoch_bag bags[3];
+
+    atomic_int in_use;
+    struct _ds_epoch_record * next;
+} ds_epoch_record;
+
+typedef struct _ds_epoch_domain {
+
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_uint epoch;
+
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(ds_epoch_record *) records;
+} ds_epoch_domain;
+
+/**
+ *  create a domain for the shared containers
+ */
+ds_epoch_domain * ds_epoch_create(void);
+
+/**
+ *  destroy the domain and records, free all retired pointers
+ *  (call it when no other thread is using the domain)
+ */
+void ds_epoch_destroy(ds_epoch_domain * domain);
+
+/**
+ *  get a record for current thread
+ */
+ds_epoch_record * ds_epoch_register(ds_epoch_domain * domain);
+
+/**
+ *  give back the record (must not be active); the retired pointers left will
+ *  be collected by the next thread using it, or when destroying the domain
+ */
+void ds_epoch_unregister(ds_epoch_domain * domain, ds_epoch_record * record);
+
+/**
+ *  start reading the shared memory (can be nested)
+ */
+void ds_epoch_enter(ds_epoch_domain * domain, ds_epoch_record * record);
+
+/**
+ *  stop reading, the pointers got must not be used after leaving
+ */
+void ds_epoch_leave(ds_epoch_domain * domain, ds_epoch_record * record);
+
+/**
+ *  defer freeing the memory which has been unlinked from shared containers
+ */
+void ds_epoch_retire(ds_epoch_domain * domain, ds_epoch_record * record,
+                     void * ptr, ds_epoch_free_func func);
+
+/**
+ *  try to advance the global epoch, and free the retired pointers safe now
+ *
+ * @return count of freed pointers
+ */
+ds_size ds_epoch_collect(ds_epoch_domain * domain, ds_epoch_record * record);
+
+/**
+ *  wait until all pointers retired by this record are freed
+ *  (must not be called in reading)
+ */
+void ds_epoch_barrier(ds_epoch_domain * domain, ds_epoch_record * record);
+
+#endif /* defined(__ds_epoch__) */
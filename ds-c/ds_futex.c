@@ -0,0 +1,122 @@
+//
+//  ds_futex.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <time.h>
+#include <errno.h>
+
+#include "ds_futex.h"
+
+#if defined(__linux__)
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#elif defined(__APPLE__)
+
+// private ulock API of Darwin (used by libc++ too)
+#define UL_COMPARE_AND_WAIT  1
+#define ULF_WAKE_ALL         0x00000100
+#define ULF_NO_ERRNO         0x01000000
+
+extern int __ulock_wait(uint32_t operation, void * addr, uint64_t value, uint32_t timeout);
+extern int __ulock_wake(uint32_t operation, void * addr, uint64_t wake_value);
+
+#endif
+
+#define DS_NSEC_PER_SEC   1000000000ULL
+#define DS_NSEC_PER_USEC  1000ULL
+
+uint64_t ds_futex_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * DS_NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+#if defined(__linux__)
+
+ds_bool ds_futex_wait(atomic_uint * word, const unsigned int expected,
+                      const uint64_t deadline)
+{
+    struct timespec ts, * timeout = NULL;
+    if (deadline > 0) {
+        // absolute time of CLOCK_MONOTONIC
+        ts.tv_sec = (time_t)(deadline / DS_NSEC_PER_SEC);
+        ts.tv_nsec = (long)(deadline % DS_NSEC_PER_SEC);
+        timeout = &ts;
+    }
+    if (syscall(SYS_futex, word, FUTEX_WAIT_BITSET_PRIVATE, expected, timeout,
+                NULL, FUTEX_BITSET_MATCH_ANY) == -1 && errno == ETIMEDOUT) {
+        return DSFalse;
+    }
+    return DSTrue;
+}
+
+void ds_futex_wake(atomic_uint * word, const int count)
+{
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+#elif defined(__APPLE__)
+
+ds_bool ds_futex_wait(atomic_uint * word, const unsigned int expected,
+                      const uint64_t deadline)
+{
+    uint32_t timeout = 0; // microseconds, 0 for no timeout
+    if (deadline > 0) {
+        uint64_t now = ds_futex_now();
+        if (now >= deadline) {
+            return DSFalse;
+        }
+        uint64_t usec = (deadline - now + DS_NSEC_PER_USEC - 1) / DS_NSEC_PER_USEC;
+        timeout = usec < UINT32_MAX ? (uint32_t)usec : UINT32_MAX;
+    }
+    int res = __ulock_wait(UL_COMPARE_AND_WAIT | ULF_NO_ERRNO, word, expected, timeout);
+    if (res == -ETIMEDOUT) {
+        return DSFalse;
+    }
+    return DSTrue;
+}
+
+void ds_futex_wake(atomic_uint * word, const int count)
+{
+    if (count >= DS_FUTEX_WAKE_ALL) {
+        __ulock_wake(UL_COMPARE_AND_WAIT | ULF_WAKE_ALL | ULF_NO_ERRNO, word, 0);
+        return;
+    }
+    // ulock wakes one thread each time, stop when no more waiters
+    for (int i = 0; i < count; ++i) {
+        if (__ulock_wake(UL_COMPARE_AND_WAIT | ULF_NO_ERRNO, word, 0) == -ENOENT) {
+            break;
+        }
+    }
+}
+
+#else
+
+ds_bool ds_futex_wait(atomic_uint * word, const unsigned int expected,
+                      const uint64_t deadline)
+{
+    // no kernel support, poll the word with short sleeps
+    struct timespec ts = {0, 50 * DS_NSEC_PER_USEC};
+    while (atomic_load(word) == expected) {
+        if (deadline > 0 && ds_futex_now() >= deadline) {
+            return DSFalse;
+        }
+        nanosleep(&ts, NULL);
+    }
+    return DSTrue;
+}
+
+void ds_futex_wake(atomic_uint * word, const int count)
+{
+    // the waiters will see the word changed by themselves
+}
+
+#endif
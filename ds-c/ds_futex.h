@@ -0,0 +1,63 @@
+//
+//  ds_futex.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_futex__
+#define __ds_futex__
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "ds_base.h"
+
+//
+//  Waiting on an address
+//
+//      A thread parks in the kernel until the 32-bit word at the address is
+//  changed and woken by another thread, with no mutex or condition variable:
+//  futex on Linux, ulock on Apple platforms, and polling with short sleeps
+//  on the others.
+//
+//  Usage:
+//      waiter: read the word, check the condition, then wait with the value
+//              read, the wait returns at once if the word changed already;
+//      waker:  change the word first, then wake the waiters.
+//
+
+// CPU hint for spinning
+static inline void ds_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// wake all waiters
+#define DS_FUTEX_WAKE_ALL  0x7fffffff
+
+/**
+ *  get time of the monotonic clock in nanoseconds, for deadlines
+ */
+uint64_t ds_futex_now(void);
+
+/**
+ *  wait until the word is not 'expected' and woken, or the deadline passed
+ *  (deadline = 0 for no timeout); it may also return spuriously
+ *
+ * @return DSFalse when the deadline passed
+ */
+ds_bool ds_futex_wait(atomic_uint * word, const unsigned int expected,
+                      const uint64_t deadline);
+
+/**
+ *  wake at most 'count' threads waiting on the word
+ */
+void ds_futex_wake(atomic_uint * word, const int count);
+
+#endif /* defined(__ds_futex__) */
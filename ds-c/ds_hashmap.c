@@ -0,0 +1,356 @@
+//
+//  ds_hashmap.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ds_futex.h"
+#include "ds_hashmap.h"
+
+// mark of the bucket moved into the next table
+static ds_hash_node _hashmap_forward;
+#define DS_HASHMAP_FORWARD  (&_hashmap_forward)
+
+// finalizer of MurmurHash3
+static inline uint64_t _hashmap_hash(const ds_data key)
+{
+    uint64_t h = (uint64_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+#define _hashmap_stripe(map, index)  ((map)->stripes + ((index) & (DS_HASHMAP_STRIPES - 1)))
+
+static inline void _hashmap_lock(ds_hash_stripe * stripe)
+{
+    while (atomic_flag_test_and_set_explicit(&stripe->lock, memory_order_acquire)) {
+        ds_cpu_relax();
+    }
+}
+
+static inline void _hashmap_unlock(ds_hash_stripe * stripe)
+{
+    atomic_flag_clear_explicit(&stripe->lock, memory_order_release);
+}
+
+static inline ds_hash_table * _hashmap_table_create(const ds_size capacity)
+{
+    size_t len = sizeof(ds_hash_table) + capacity * sizeof(_Atomic(ds_hash_node *));
+    ds_hash_table * table = (ds_hash_table *)calloc(1, len);
+    table->capacity = capacity;
+    return table;
+}
+
+static inline ds_hash_node * _hashmap_node_create(const ds_data key, const ds_data value,
+                                                  ds_hash_node * next)
+{
+    ds_hash_node * node = (ds_hash_node *)malloc(sizeof(ds_hash_node));
+    node->key = key;
+    atomic_init(&node->value, value);
+    atomic_init(&node->next, next);
+    return node;
+}
+
+// copy nodes of bucket 'index' into the next table, and forward the bucket
+// (the stripe of this bucket must be locked)
+static void _hashmap_migrate(ds_hashmap * map, ds_epoch_record * record,
+                             ds_hash_table * table, const ds_size index)
+{
+    ds_hash_table * next = atomic_load_explicit(&table->next, memory_order_acquire);
+    _Atomic(ds_hash_node *) * bucket = table->buckets + index;
+    ds_hash_node * node = atomic_load_explicit(bucket, memory_order_relaxed);
+    if (node == DS_HASHMAP_FORWARD) {
+        return;
+    }
+    // 1. copy, the old nodes may still be read
+    ds_hash_node * low = NULL;
+    ds_hash_node * high = NULL;
+    ds_data value;
+    for (ds_hash_node * p = node; p; p = atomic_load_explicit(&p->next, memory_order_relaxed)) {
+        value = atomic_load_explicit(&p->value, memory_order_relaxed);
+        if (_hashmap_hash(p->key) & table->capacity) {
+            high = _hashmap_node_create(p->key, value, high);
+        } else {
+            low = _hashmap_node_create(p->key, value, low);
+        }
+    }
+    atomic_store_explicit(next->buckets + index, low, memory_order_release);
+    atomic_store_explicit(next->buckets + index + table->capacity, high, memory_order_release);
+    // 2. forward readers to the next table
+    atomic_store_explicit(bucket, DS_HASHMAP_FORWARD, memory_order_release);
+    ds_hash_node * following;
+    for (; node; node = following) {
+        following = atomic_load_explicit(&node->next, memory_order_relaxed);
+        ds_epoch_retire(map->domain, record, node, NULL);
+    }
+    // 3. the last one replaces the table
+    if (atomic_fetch_add(&table->migrated, 1) + 1 == table->capacity) {
+        atomic_store_explicit(&map->table, next, memory_order_release);
+        ds_epoch_retire(map->domain, record, table, NULL);
+    }
+}
+
+// move a few buckets for the resizing table
+static void _hashmap_help(ds_hashmap * map, ds_epoch_record * record)
+{
+    ds_hash_table * table = atomic_load_explicit(&map->table, memory_order_acquire);
+    if (!atomic_load_explicit(&table->next, memory_order_acquire)) {
+        return;
+    }
+    ds_size index;
+    ds_hash_stripe * stripe;
+    for (int step = 0; step < DS_HASHMAP_MIGRATE_STEP; ++step) {
+        index = atomic_fetch_add(&table->migrate_index, 1);
+        if (index >= table->capacity) {
+            break;
+        }
+        stripe = _hashmap_stripe(map, index);
+        _hashmap_lock(stripe);
+        _hashmap_migrate(map, record, table, index);
+        _hashmap_unlock(stripe);
+    }
+}
+
+// start doubling the table, if not resizing yet
+static void _hashmap_grow(ds_hashmap * map)
+{
+    ds_hash_table * table = atomic_load_explicit(&map->table, memory_order_acquire);
+    if (atomic_load_explicit(&table->next, memory_order_relaxed)) {
+        return;
+    }
+    ds_hash_table * next = _hashmap_table_create(table->capacity * 2);
+    ds_hash_table * expected = NULL;
+    if (!atomic_compare_exchange_strong(&table->next, &expected, next)) {
+        // another thread won
+        free(next);
+    }
+}
+
+// get the bucket for writing, moving it from the resizing tables
+// (the stripe must be locked)
+static inline _Atomic(ds_hash_node *) * _hashmap_bucket(ds_hashmap * map,
+                                                        ds_epoch_record * record,
+                                                        const uint64_t hash)
+{
+    ds_hash_table * table = atomic_load_explicit(&map->table, memory_order_acquire);
+    ds_size index = (ds_size)(hash & (table->capacity - 1));
+    while (atomic_load_explicit(&table->next, memory_order_acquire)) {
+        _hashmap_migrate(map, record, table, index);
+        table = atomic_load_explicit(&table->next, memory_order_acquire);
+        index = (ds_size)(hash & (table->capacity - 1));
+    }
+    return table->buckets + index;
+}
+
+static inline ds_hash_node * _hashmap_find(_Atomic(ds_hash_node *) * bucket, const ds_data key)
+{
+    ds_hash_node * node = atomic_load_explicit(bucket, memory_order_acquire);
+    for (; node; node = atomic_load_explicit(&node->next, memory_order_acquire)) {
+        if (node->key == key) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+// insert a new node at head of the bucket (the stripe must be locked)
+static inline void _hashmap_insert(ds_hash_stripe * stripe,
+                                   _Atomic(ds_hash_node *) * bucket,
+                                   const ds_data key, const ds_data value)
+{
+    ds_hash_node * head = atomic_load_explicit(bucket, memory_order_relaxed);
+    atomic_store_explicit(bucket, _hashmap_node_create(key, value, head), memory_order_release);
+    atomic_fetch_add_explicit(&stripe->count, 1, memory_order_relaxed);
+}
+
+// check the load factor (1.0) of the stripe after inserting
+static inline ds_bool _hashmap_overloaded(ds_hashmap * map, ds_hash_stripe * stripe)
+{
+    ds_hash_table * table = atomic_load_explicit(&map->table, memory_order_relaxed);
+    ds_size count = atomic_load_explicit(&stripe->count, memory_order_relaxed);
+    return count > table->capacity / DS_HASHMAP_STRIPES;
+}
+
+#pragma mark -
+
+ds_hashmap * ds_hashmap_create(ds_epoch_domain * domain, const ds_size capacity)
+{
+    // aligned to cache line for the padded stripes
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_hashmap)) != 0) {
+        return NULL;
+    }
+    ds_hashmap * map = (ds_hashmap *)ptr;
+    memset(map, 0, sizeof(ds_hashmap));
+    ds_size size = DS_HASHMAP_STRIPES;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    atomic_init(&map->table, _hashmap_table_create(size));
+    map->domain = domain;
+    for (int index = 0; index < DS_HASHMAP_STRIPES; ++index) {
+        atomic_flag_clear(&map->stripes[index].lock);
+        atomic_init(&map->stripes[index].count, 0);
+    }
+    return map;
+}
+
+void ds_hashmap_destroy(ds_hashmap * map)
+{
+    ds_hash_table * table = atomic_load(&map->table);
+    ds_hash_table * next;
+    ds_hash_node * node;
+    ds_hash_node * following;
+    for (; table; table = next) {
+        next = atomic_load(&table->next);
+        for (ds_size index = 0; index < table->capacity; ++index) {
+            node = atomic_load(table->buckets + index);
+            if (node == DS_HASHMAP_FORWARD) {
+                continue;
+            }
+            for (; node; node = following) {
+                following = atomic_load(&node->next);
+                free(node);
+            }
+        }
+        free(table);
+    }
+    free(map);
+}
+
+ds_size ds_hashmap_length(ds_hashmap * map)
+{
+    ds_size count = 0;
+    for (int index = 0; index < DS_HASHMAP_STRIPES; ++index) {
+        count += atomic_load_explicit(&map->stripes[index].count, memory_order_relaxed);
+    }
+    return count;
+}
+
+ds_bool ds_hashmap_get(ds_hashmap * map, ds_epoch_record * record,
+                       const ds_data key, ds_data * value)
+{
+    uint64_t hash = _hashmap_hash(key);
+    ds_bool found = DSFalse;
+    ds_epoch_enter(map->domain, record);
+    ds_hash_table * table = atomic_load_explicit(&map->table, memory_order_acquire);
+    ds_hash_node * node;
+    for (;;) {
+        node = atomic_load_explicit(table->buckets + (hash & (table->capacity - 1)),
+                                    memory_order_acquire);
+        if (node != DS_HASHMAP_FORWARD) {
+            break;
+        }
+        // moved
+        table = atomic_load_explicit(&table->next, memory_order_acquire);
+    }
+    for (; node; node = atomic_load_explicit(&node->next, memory_order_acquire)) {
+        if (node->key == key) {
+            *value = atomic_load_explicit(&node->value, memory_order_acquire);
+            found = DSTrue;
+            break;
+        }
+    }
+    ds_epoch_leave(map->domain, record);
+    return found;
+}
+
+ds_bool ds_hashmap_put(ds_hashmap * map, ds_epoch_record * record,
+                       const ds_data key, const ds_data value)
+{
+    uint64_t hash = _hashmap_hash(key);
+    ds_hash_stripe * stripe = _hashmap_stripe(map, hash);
+    ds_bool inserted = DSFalse;
+    ds_epoch_enter(map->domain, record);
+    _hashmap_lock(stripe);
+    _Atomic(ds_hash_node *) * bucket = _hashmap_bucket(map, record, hash);
+    ds_hash_node * node = _hashmap_find(bucket, key);
+    if (node) {
+        atomic_store_explicit(&node->value, value, memory_order_release);
+    } else {
+        _hashmap_insert(stripe, bucket, key, value);
+        inserted = DSTrue;
+    }
+    _hashmap_unlock(stripe);
+    if (inserted && _hashmap_overloaded(map, stripe)) {
+        _hashmap_grow(map);
+    }
+    _hashmap_help(map, record);
+    ds_epoch_leave(map->domain, record);
+    return inserted;
+}
+
+ds_data ds_hashmap_compute_if_absent(ds_hashmap * map, ds_epoch_record * record,
+                                     const ds_data key,
+                                     ds_hashmap_compute_func func, void * ctx)
+{
+    // 1. try without lock
+    ds_data value;
+    if (ds_hashmap_get(map, record, key, &value)) {
+        return value;
+    }
+    // 2. check again with the stripe locked
+    uint64_t hash = _hashmap_hash(key);
+    ds_hash_stripe * stripe = _hashmap_stripe(map, hash);
+    ds_bool inserted = DSFalse;
+    ds_epoch_enter(map->domain, record);
+    _hashmap_lock(stripe);
+    _Atomic(ds_hash_node *) * bucket = _hashmap_bucket(map, record, hash);
+    ds_hash_node * node = _hashmap_find(bucket, key);
+    if (node) {
+        value = atomic_load_explicit(&node->value, memory_order_relaxed);
+    } else {
+        value = func(key, ctx);
+        _hashmap_insert(stripe, bucket, key, value);
+        inserted = DSTrue;
+    }
+    _hashmap_unlock(stripe);
+    if (inserted && _hashmap_overloaded(map, stripe)) {
+        _hashmap_grow(map);
+    }
+    _hashmap_help(map, record);
+    ds_epoch_leave(map->domain, record);
+    return value;
+}
+
+ds_bool ds_hashmap_remove(ds_hashmap * map, ds_epoch_record * record,
+                          const ds_data key, ds_data * value)
+{
+    uint64_t hash = _hashmap_hash(key);
+    ds_hash_stripe * stripe = _hashmap_stripe(map, hash);
+    ds_hash_node * node = NULL;
+    ds_epoch_enter(map->domain, record);
+    _hashmap_lock(stripe);
+    _Atomic(ds_hash_node *) * link = _hashmap_bucket(map, record, hash);
+    for (node = atomic_load_explicit(link, memory_order_relaxed); node;
+         node = atomic_load_explicit(link, memory_order_relaxed)) {
+        if (node->key == key) {
+            // unlink, readers on it can still go ahead
+            atomic_store_explicit(link, atomic_load_explicit(&node->next, memory_order_relaxed),
+                                  memory_order_release);
+            atomic_fetch_sub_explicit(&stripe->count, 1, memory_order_relaxed);
+            break;
+        }
+        link = &node->next;
+    }
+    _hashmap_unlock(stripe);
+    if (node) {
+        if (value) {
+            *value = atomic_load_explicit(&node->value, memory_order_relaxed);
+        }
+        ds_epoch_retire(map->domain, record, node, NULL);
+    }
+    _hashmap_help(map, record);
+    ds_epoch_leave(map->domain, record);
+    return node ? DSTrue : DSFalse;
+}
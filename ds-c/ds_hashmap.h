@@ -0,0 +1,126 @@
+//
+//  ds_hashmap.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_hashmap__
+#define __ds_hashmap__
+
+#include <stdatomic.h>
+
+#include "ds_base.h"
+#include "ds_epoch.h"
+
+//
+//  Concurrent hash map (key -> value, both are words, e.g.: ID -> pointer)
+//
+//      Readers never lock: they go through the buckets by atomic loads, and
+//  the nodes/tables removed are freed by epoch-based reclamation, so every
+//  call takes the epoch record of current thread (which may enter once for
+//  a batch of lookups, entering is nested).
+//
+//      Writers lock one of the stripes, which is chosen by the bucket index,
+//  so the keys of bucket 'i' in a table and buckets 'i', 'i + capacity' in
+//  the doubled table are always guarded by the same stripe.
+//
+//      Resizing is incremental: the doubled table is attached to the current
+//  one, then each writer moves the bucket it needs (and a few more) by
+//  copying the nodes into the new table and leaving a forwarding mark in
+//  the old bucket; readers follow the mark. When all buckets are moved, the
+//  new table takes the place and the old one is retired.
+//
+
+#define DS_HASHMAP_STRIPES       64  // power of two
+#define DS_HASHMAP_MIGRATE_STEP  16  // buckets moved by each writer
+
+/**
+ *  Called by 'ds_hashmap_compute_if_absent' (with the stripe locked)
+ *
+ * @return value for the key
+ */
+typedef ds_data (*ds_hashmap_compute_func)(const ds_data key, void * ctx);
+
+typedef struct _ds_hash_node {
+    ds_data key;
+    _Atomic(ds_data) value;
+    _Atomic(struct _ds_hash_node *) next;
+} ds_hash_node;
+
+typedef struct _ds_hash_table {
+    ds_size capacity; // power of two, not less than DS_HASHMAP_STRIPES
+    _Atomic(struct _ds_hash_table *) next; // doubled table when resizing
+    atomic_int migrate_index; // next bucket to move by helpers
+    atomic_int migrated;      // count of moved buckets
+    _Atomic(ds_hash_node *) buckets[];
+} ds_hash_table;
+
+typedef struct _ds_hash_stripe {
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_flag lock;
+    atomic_int count; // items guarded by this stripe
+} ds_hash_stripe;
+
+typedef struct _ds_hashmap {
+
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(ds_hash_table *) table;
+
+    ds_epoch_domain * domain;
+
+    ds_hash_stripe stripes[DS_HASHMAP_STRIPES];
+} ds_hashmap;
+
+/**
+ *  create a map with capacity (buckets count, rounded up to power of two),
+ *  removed memory will be retired into the epoch domain
+ */
+ds_hashmap * ds_hashmap_create(ds_epoch_domain * domain, const ds_size capacity);
+
+/**
+ *  destroy the map and all nodes (no other thread is using it);
+ *  memory retired before is still kept by the domain
+ */
+void ds_hashmap_destroy(ds_hashmap * map);
+
+/**
+ *  get items count (just a snapshot)
+ */
+ds_size ds_hashmap_length(ds_hashmap * map);
+
+/**
+ *  get value for the key (lock-free)
+ *
+ * @return DSFalse when not found
+ */
+ds_bool ds_hashmap_get(ds_hashmap * map, ds_epoch_record * record,
+                       const ds_data key, ds_data * value);
+
+/**
+ *  set value for the key
+ *
+ * @return DSTrue when inserted, DSFalse when replaced
+ */
+ds_bool ds_hashmap_put(ds_hashmap * map, ds_epoch_record * record,
+                       const ds_data key, const ds_data value);
+
+/**
+ *  get value for the key, or insert the value computed if not found;
+ *  the function is called at most once, no other writer can set the key
+ *  while computing
+ *
+ * @return value for the key
+ */
+ds_data ds_hashmap_compute_if_absent(ds_hashmap * map, ds_epoch_record * record,
+                                     const ds_data key,
+                                     ds_hashmap_compute_func func, void * ctx);
+
+/**
+ *  remove the key, and get the value removed (if value is not NULL)
+ *
+ * @return DSFalse when not found
+ */
+ds_bool ds_hashmap_remove(ds_hashmap * map, ds_epoch_record * record,
+                          const ds_data key, ds_data * value);
+
+#endif /* defined(__ds_hashmap__) */
@@ -0,0 +1,392 @@
+//
+//  ds_heap.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_heap.h"
+
+#define DS_HEAP_PARENT(index)  (((index) - 1) / DS_HEAP_ARITY)
+#define DS_HEAP_CHILD(index)   ((index) * DS_HEAP_ARITY + 1)
+
+// the leading bytes of the item as a value for comparing,
+// small items are sign-extended as the integer type of the same size
+static inline ds_data _heap_value(const ds_data * item, const ds_size item_size)
+{
+    switch (item_size) {
+        case sizeof(signed char):
+            return *(const signed char *)item;
+        case sizeof(short):
+            return *(const short *)item;
+        case sizeof(int):
+            return *(const int *)item;
+        default:
+            break;
+    }
+    ds_data value = DSZero;
+    memcpy(&value, item, item_size < (ds_size)sizeof(ds_data) ? item_size : (ds_size)sizeof(ds_data));
+    return value;
+}
+
+#define _heap_compare(heap, left, right)                                       \
+    ({                                                                         \
+        ds_data __v1 = _heap_value(left, (heap)->item_size);                   \
+        ds_data __v2 = _heap_value(right, (heap)->item_size);                  \
+        (heap)->fn.compare ? (heap)->fn.compare(__v1, __v2) :                  \
+        (heap)->bk.compare ? (heap)->bk.compare(__v1, __v2) :                  \
+        __v1 < __v2 ? DSAscending : __v1 > __v2 ? DSDescending : DSSame;       \
+    })                                                                         \
+                                                       /* EOF '_heap_compare' */
+
+#define _heap_assign(heap, dest, src)                                          \
+    do {                                                                       \
+        if ((heap)->fn.assign) {                                               \
+            (heap)->fn.assign(dest, src, (heap)->item_size);                   \
+        } else if ((heap)->bk.assign) {                                        \
+            (heap)->bk.assign(dest, src, (heap)->item_size);                   \
+        } else {                                                               \
+            memcpy(dest, &(src), (heap)->item_size);                           \
+        }                                                                      \
+    } while (0)                                                                \
+                                                        /* EOF '_heap_assign' */
+
+#pragma mark Heap base on ds_array
+
+//
+//  Notice:
+//      The space after the last item is used for holding the moving item,
+//      so the capacity is always bigger than the count.
+//
+
+static inline void _heap_reserve(ds_heap * heap, const ds_size count)
+{
+    if (heap->capacity >= count) {
+        return;
+    }
+    while (heap->capacity < count) {
+        heap->capacity *= 2;
+    }
+    heap->items = (ds_data *)realloc(heap->items, heap->capacity * heap->item_size);
+}
+
+// move the item from 'hole' down to its position in heap[0, count)
+static inline void _heap_sift_down(ds_heap * heap, ds_size hole,
+                                   const ds_data * item, const ds_size count)
+{
+    ds_size child, best, last;
+    ds_data * ptr;
+    for (;;) {
+        child = DS_HEAP_CHILD(hole);
+        if (child >= count) {
+            break;
+        }
+        // the smallest child
+        best = child;
+        last = child + DS_HEAP_ARITY < count ? child + DS_HEAP_ARITY : count;
+        for (++child; child < last; ++child) {
+            if (_heap_compare(heap, ds_array_at(heap, child), ds_array_at(heap, best)) < 0) {
+                best = child;
+            }
+        }
+        ptr = ds_array_at(heap, best);
+        if (_heap_compare(heap, ptr, item) >= 0) {
+            break;
+        }
+        memcpy(ds_array_at(heap, hole), ptr, heap->item_size);
+        hole = best;
+    }
+    memcpy(ds_array_at(heap, hole), item, heap->item_size);
+}
+
+ds_heap * ds_heap_create(const ds_size item_size, const ds_size capacity)
+{
+    return ds_array_create(item_size, capacity);
+}
+
+void ds_heap_destroy(ds_heap * heap)
+{
+    ds_array_destroy(heap);
+}
+
+ds_size ds_heap_length(const ds_heap * heap)
+{
+    return ds_array_length(heap);
+}
+
+ds_bool ds_heap_empty(const ds_heap * heap)
+{
+    return ds_array_empty(heap);
+}
+
+void ds_heap_clear(ds_heap * heap)
+{
+    ds_array_clear(heap);
+}
+
+void ds_heap_push(ds_heap * heap, const ds_data item)
+{
+    // one more space for holding the new item
+    _heap_reserve(heap, heap->count + 2);
+    ds_data * tmp = ds_array_at(heap, heap->count + 1);
+    _heap_assign(heap, tmp, item);
+
+    // move parents down until the new item fits
+    ds_size hole = heap->count;
+    ds_size parent;
+    ds_data * ptr;
+    while (hole > 0) {
+        parent = DS_HEAP_PARENT(hole);
+        ptr = ds_array_at(heap, parent);
+        if (_heap_compare(heap, tmp, ptr) >= 0) {
+            break;
+        }
+        memcpy(ds_array_at(heap, hole), ptr, heap->item_size);
+        hole = parent;
+    }
+    memcpy(ds_array_at(heap, hole), tmp, heap->item_size);
+    heap->count += 1;
+}
+
+ds_data * ds_heap_pop(ds_heap * heap)
+{
+    if (heap->count == 0) {
+        return NULL;
+    }
+    ds_size last = heap->count - 1;
+    heap->count = last;
+    if (last == 0) {
+        return ds_array_at(heap, 0);
+    }
+    _heap_reserve(heap, last + 2);
+    // 1. hold the last item, and move the top item to its space
+    ds_data * tmp = ds_array_at(heap, last + 1);
+    ds_data * top = ds_array_at(heap, last);
+    memcpy(tmp, top, heap->item_size);
+    memcpy(top, ds_array_at(heap, 0), heap->item_size);
+    // 2. put the last item from the top down
+    _heap_sift_down(heap, 0, tmp, last);
+    return top;
+}
+
+ds_data * ds_heap_peek(const ds_heap * heap)
+{
+    return heap->count > 0 ? ds_array_at(heap, 0) : NULL;
+}
+
+void ds_heap_heapify(ds_heap * heap)
+{
+    if (heap->count <= 1) {
+        return;
+    }
+    _heap_reserve(heap, heap->count + 1);
+    ds_data * tmp = ds_array_at(heap, heap->count);
+    // sift down all parents, from the last one to the top
+    ds_size index = DS_HEAP_PARENT(heap->count - 1) + 1;
+    while (index-- > 0) {
+        memcpy(tmp, ds_array_at(heap, index), heap->item_size);
+        _heap_sift_down(heap, index, tmp, heap->count);
+    }
+}
+
+#pragma mark - Indexed heap
+
+#define _indexed_heap_item(heap, handle)                                       \
+            ((ds_data *)((ds_byte *)(heap)->items + (handle) * (heap)->item_size))
+
+#define _indexed_heap_less(heap, h1, h2)                                       \
+            (_heap_compare(heap, _indexed_heap_item(heap, h1),                 \
+                                 _indexed_heap_item(heap, h2)) < 0)
+
+static inline void _indexed_heap_set(ds_indexed_heap * heap,
+                                     const ds_size pos, const ds_size handle)
+{
+    heap->heap[pos] = handle;
+    heap->positions[handle] = pos;
+}
+
+static inline void _indexed_heap_expand(ds_indexed_heap * heap)
+{
+    heap->capacity *= 2;
+    heap->heap = (ds_size *)realloc(heap->heap, heap->capacity * sizeof(ds_size));
+    heap->positions = (ds_size *)realloc(heap->positions, heap->capacity * sizeof(ds_size));
+    heap->items = (ds_data *)realloc(heap->items, heap->capacity * heap->item_size);
+}
+
+static inline void _indexed_heap_sift_up(ds_indexed_heap * heap, ds_size pos)
+{
+    ds_size handle = heap->heap[pos];
+    ds_size parent;
+    while (pos > 0) {
+        parent = DS_HEAP_PARENT(pos);
+        if (!_indexed_heap_less(heap, handle, heap->heap[parent])) {
+            break;
+        }
+        _indexed_heap_set(heap, pos, heap->heap[parent]);
+        pos = parent;
+    }
+    _indexed_heap_set(heap, pos, handle);
+}
+
+static inline void _indexed_heap_sift_down(ds_indexed_heap * heap, ds_size pos)
+{
+    ds_size handle = heap->heap[pos];
+    ds_size child, best, last;
+    for (;;) {
+        child = DS_HEAP_CHILD(pos);
+        if (child >= heap->count) {
+            break;
+        }
+        // the smallest child
+        best = child;
+        last = child + DS_HEAP_ARITY < heap->count ? child + DS_HEAP_ARITY : heap->count;
+        for (++child; child < last; ++child) {
+            if (_indexed_heap_less(heap, heap->heap[child], heap->heap[best])) {
+                best = child;
+            }
+        }
+        if (!_indexed_heap_less(heap, heap->heap[best], handle)) {
+            break;
+        }
+        _indexed_heap_set(heap, pos, heap->heap[best]);
+        pos = best;
+    }
+    _indexed_heap_set(heap, pos, handle);
+}
+
+// swap the item at 'pos' with the last one, and remove it from the heap
+static inline void _indexed_heap_remove_at(ds_indexed_heap * heap, const ds_size pos)
+{
+    ds_size last = heap->count - 1;
+    ds_size handle = heap->heap[pos];
+    heap->count = last;
+    if (pos == last) {
+        return;
+    }
+    _indexed_heap_set(heap, pos, heap->heap[last]);
+    // the removed handle becomes the first free one
+    _indexed_heap_set(heap, last, handle);
+    if (pos > 0 && _indexed_heap_less(heap, heap->heap[pos], heap->heap[DS_HEAP_PARENT(pos)])) {
+        _indexed_heap_sift_up(heap, pos);
+    } else {
+        _indexed_heap_sift_down(heap, pos);
+    }
+}
+
+#pragma mark -
+
+ds_indexed_heap * ds_indexed_heap_create(const ds_size item_size,
+                                         const ds_size capacity)
+{
+    ds_indexed_heap * heap = (ds_indexed_heap *)malloc(sizeof(ds_indexed_heap));
+    memset(heap, 0, sizeof(ds_indexed_heap));
+    heap->capacity = capacity > 0 ? capacity : 8;
+    heap->item_size = item_size > 0 ? item_size : (ds_size)sizeof(ds_data);
+    heap->heap = (ds_size *)malloc(heap->capacity * sizeof(ds_size));
+    heap->positions = (ds_size *)malloc(heap->capacity * sizeof(ds_size));
+    heap->items = (ds_data *)calloc(heap->capacity, heap->item_size);
+    return heap;
+}
+
+void ds_indexed_heap_destroy(ds_indexed_heap * heap)
+{
+    free(heap->heap);
+    heap->heap = NULL;
+    free(heap->positions);
+    heap->positions = NULL;
+    free(heap->items);
+    heap->items = NULL;
+    free(heap);
+}
+
+ds_size ds_indexed_heap_length(const ds_indexed_heap * heap)
+{
+    return heap->count;
+}
+
+ds_bool ds_indexed_heap_empty(const ds_indexed_heap * heap)
+{
+    return heap->count == 0;
+}
+
+void ds_indexed_heap_clear(ds_indexed_heap * heap)
+{
+    heap->count = 0;
+    heap->size = 0;
+}
+
+ds_bool ds_indexed_heap_contains(const ds_indexed_heap * heap, const ds_size handle)
+{
+    return 0 <= handle && handle < heap->size && heap->positions[handle] < heap->count;
+}
+
+ds_data * ds_indexed_heap_at(const ds_indexed_heap * heap, const ds_size handle)
+{
+    //assert(0 <= handle && handle < heap->size);
+    return _indexed_heap_item(heap, handle);
+}
+
+ds_size ds_indexed_heap_push(ds_indexed_heap * heap, const ds_data item)
+{
+    ds_size handle;
+    if (heap->count < heap->size) {
+        // reuse the first free handle
+        handle = heap->heap[heap->count];
+    } else {
+        if (heap->size >= heap->capacity) {
+            _indexed_heap_expand(heap);
+        }
+        handle = heap->size;
+        heap->size += 1;
+        _indexed_heap_set(heap, heap->count, handle);
+    }
+    ds_data * dest = _indexed_heap_item(heap, handle);
+    _heap_assign(heap, dest, item);
+    heap->count += 1;
+    _indexed_heap_sift_up(heap, heap->count - 1);
+    return handle;
+}
+
+ds_size ds_indexed_heap_pop(ds_indexed_heap * heap)
+{
+    if (heap->count == 0) {
+        return DSNotFound;
+    }
+    ds_size handle = heap->heap[0];
+    _indexed_heap_remove_at(heap, 0);
+    return handle;
+}
+
+ds_size ds_indexed_heap_peek(const ds_indexed_heap * heap)
+{
+    return heap->count > 0 ? heap->heap[0] : DSNotFound;
+}
+
+void ds_indexed_heap_update(ds_indexed_heap * heap, const ds_size handle,
+                            const ds_data item)
+{
+    ds_data * dest = _indexed_heap_item(heap, handle);
+    _heap_assign(heap, dest, item);
+    ds_indexed_heap_fix(heap, handle);
+}
+
+void ds_indexed_heap_fix(ds_indexed_heap * heap, const ds_size handle)
+{
+    //assert(ds_indexed_heap_contains(heap, handle));
+    ds_size pos = heap->positions[handle];
+    if (pos > 0 && _indexed_heap_less(heap, handle, heap->heap[DS_HEAP_PARENT(pos)])) {
+        _indexed_heap_sift_up(heap, pos);
+    } else {
+        _indexed_heap_sift_down(heap, pos);
+    }
+}
+
+void ds_indexed_heap_remove(ds_indexed_heap * heap, const ds_size handle)
+{
+    //assert(ds_indexed_heap_contains(heap, handle));
+    _indexed_heap_remove_at(heap, heap->positions[handle]);
+}
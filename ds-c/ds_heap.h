@@ -0,0 +1,193 @@
+//
+//  ds_heap.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_heap__
+#define __ds_heap__
+
+#include "ds_array.h"
+
+//
+//  Priority queue (d-ary heap)
+//
+//      The item compared smallest by 'fn.compare' or 'bk.compare' is on top,
+//  each node has 'DS_HEAP_ARITY' children, a wider heap is lower, so pushing
+//  compares less, and popping scans the children in the same cache line.
+//
+//      Without a compare hook, the leading word of the items is compared as
+//  a signed integer (items of 1, 2 or 4 bytes are sign-extended as char,
+//  short or int); set a compare hook for the other kinds of keys.
+//
+
+#ifndef DS_HEAP_ARITY
+#define DS_HEAP_ARITY 4
+#endif
+
+#pragma mark Heap base on ds_array
+
+typedef ds_data         ds_heap_node;
+typedef ds_array        ds_heap;
+
+/**
+ *  create a heap with item size and capacity
+ */
+ds_heap * ds_heap_create(const ds_size item_size, const ds_size capacity);
+
+/**
+ *  destroy the heap struct and its items
+ */
+void ds_heap_destroy(ds_heap * heap);
+
+/**
+ *  get items count
+ */
+ds_size ds_heap_length(const ds_heap * heap);
+
+/**
+ *  check whether the heap is empty
+ */
+ds_bool ds_heap_empty(const ds_heap * heap);
+
+/**
+ *  clear the heap
+ */
+void ds_heap_clear(ds_heap * heap);
+
+/**
+ *  add the item into the heap
+ */
+void ds_heap_push(ds_heap * heap, const ds_data item);
+
+/**
+ *  remove the top item from the heap and return it (but NOT erase),
+ *  the item is valid until next push
+ */
+ds_heap_node * ds_heap_pop(ds_heap * heap);
+
+/**
+ *  get the top item (not removed), or NULL when the heap is empty
+ */
+ds_heap_node * ds_heap_peek(const ds_heap * heap);
+
+/**
+ *  rebuild the heap in O(n) after items appended by 'ds_array_append()'
+ */
+void ds_heap_heapify(ds_heap * heap);
+
+#pragma mark - Indexed heap
+
+//
+//      Each pushed item gets a handle, which stays the same while the item is
+//  moving in the heap, so the item can be updated (e.g.: decrease-key) or
+//  removed in O(log n) by its handle; the handle of a removed item will be
+//  reused by next push.
+//
+//      The handles are kept in 'heap', the first 'count' of them are in heap
+//  order, and the rest are the free ones; 'positions' maps each handle back
+//  to its position in 'heap'.
+//
+
+typedef struct _ds_indexed_heap {
+
+    ds_size capacity; // max count of handles
+    ds_size count;    // count of items in heap
+    ds_size size;     // count of handles ever given
+
+    ds_size * heap;      // handles, by heap order
+    ds_size * positions; // positions in heap, by handle
+
+    ds_size item_size;
+    ds_data * items;     // items, by handle
+
+    // functions
+    struct {
+	    ds_assign_func   assign;
+	    ds_erase_func    erase;
+	    ds_compare_func  compare;
+    } fn;
+    // blocks
+    struct {
+	    ds_assign_block  assign;
+	    ds_erase_block   erase;
+	    ds_compare_block compare;
+    } bk;
+} ds_indexed_heap;
+
+/**
+ *  create an indexed heap with item size and capacity
+ */
+ds_indexed_heap * ds_indexed_heap_create(const ds_size item_size,
+                                         const ds_size capacity);
+
+/**
+ *  destroy the heap struct and its items
+ */
+void ds_indexed_heap_destroy(ds_indexed_heap * heap);
+
+/**
+ *  get items count
+ */
+ds_size ds_indexed_heap_length(const ds_indexed_heap * heap);
+
+/**
+ *  check whether the heap is empty
+ */
+ds_bool ds_indexed_heap_empty(const ds_indexed_heap * heap);
+
+/**
+ *  remove all items, all handles become invalid
+ */
+void ds_indexed_heap_clear(ds_indexed_heap * heap);
+
+/**
+ *  check whether the handle is an item in the heap
+ */
+ds_bool ds_indexed_heap_contains(const ds_indexed_heap * heap, const ds_size handle);
+
+/**
+ *  get the item with handle
+ */
+ds_data * ds_indexed_heap_at(const ds_indexed_heap * heap, const ds_size handle);
+
+/**
+ *  add the item into the heap
+ *
+ * @return handle of the item
+ */
+ds_size ds_indexed_heap_push(ds_indexed_heap * heap, const ds_data item);
+
+/**
+ *  remove the top item from the heap (but NOT erase)
+ *
+ * @return handle of the removed item, its data is valid until next push;
+ *         or DSNotFound when the heap is empty
+ */
+ds_size ds_indexed_heap_pop(ds_indexed_heap * heap);
+
+/**
+ *  get handle of the top item (not removed), or DSNotFound when the heap is empty
+ */
+ds_size ds_indexed_heap_peek(const ds_indexed_heap * heap);
+
+/**
+ *  set new data to the item with handle and move it to the right position
+ *  (decrease-key or increase-key)
+ */
+void ds_indexed_heap_update(ds_indexed_heap * heap, const ds_size handle,
+                            const ds_data item);
+
+/**
+ *  move the item to the right position after it was changed in place
+ */
+void ds_indexed_heap_fix(ds_indexed_heap * heap, const ds_size handle);
+
+/**
+ *  remove the item with handle from the heap (but NOT erase)
+ */
+void ds_indexed_heap_remove(ds_indexed_heap * heap, const ds_size handle);
+
+#endif /* defined(__ds_heap__) */
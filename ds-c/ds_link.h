@@ -0,0 +1,260 @@
+//
+//  ds_link.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_link__
+#define __ds_link__
+
+#include <stddef.h>
+
+#include "ds_base.h"
+
+//
+//  Intrusive list
+//
+//      The link lives inside the user's struct, so adding an existing object
+//  into a list/queue/stack needs no memory allocation and never copies it;
+//  get the object back from its link with 'ds_container_of'.
+//
+//      The list is circular with a sentinel node, so all operations are O(1);
+//  the list never frees anything, the owner must remove the objects before
+//  destroying them.
+//
+//  Usage:
+//
+//      typedef struct {
+//          int id;
+//          ds_link link;
+//      } session;
+//
+//      ds_link_list list;
+//      ds_link_list_init(&list);
+//      ds_link_list_append(&list, &sess->link);
+//
+//      ds_link * link;
+//      DS_LINK_LIST_FOR_EACH(&list, link) {
+//          session * sess = ds_container_of(link, session, link);
+//      }
+//
+
+#define ds_container_of(ptr, type, member)                                     \
+    ((type *)((ds_byte *)(ptr) - offsetof(type, member)))                      \
+                                                     /* EOF 'ds_container_of' */
+
+#define DS_LINK_LIST_FOR_EACH(list, link)                                      \
+    for ((link) = (list)->head.next; (link) != &(list)->head;                  \
+         (link) = (link)->next)                                                \
+                                               /* EOF 'DS_LINK_LIST_FOR_EACH' */
+
+#define DS_LINK_LIST_FOR_EACH_REVERSE(list, link)                              \
+    for ((link) = (list)->head.prev; (link) != &(list)->head;                  \
+         (link) = (link)->prev)                                                \
+                                       /* EOF 'DS_LINK_LIST_FOR_EACH_REVERSE' */
+
+// the current link can be removed in the loop
+#define DS_LINK_LIST_FOR_EACH_SAFE(list, link, tmp)                            \
+    for ((link) = (list)->head.next, (tmp) = (link)->next;                     \
+         (link) != &(list)->head;                                              \
+         (link) = (tmp), (tmp) = (link)->next)                                 \
+                                          /* EOF 'DS_LINK_LIST_FOR_EACH_SAFE' */
+
+typedef struct _ds_link {
+    struct _ds_link * next;
+    struct _ds_link * prev;
+} ds_link;
+
+typedef struct _ds_link_list {
+    ds_link head; // sentinel, head.next is the first link, head.prev is the last
+    ds_size count;
+} ds_link_list;
+
+/**
+ *  set the link as not linked
+ */
+static inline void ds_link_init(ds_link * link)
+{
+    link->next = link;
+    link->prev = link;
+}
+
+/**
+ *  check whether the link is in a list
+ */
+static inline ds_bool ds_link_linked(const ds_link * link)
+{
+    return link->next != link;
+}
+
+/**
+ *  initialize an empty list (no need to destroy)
+ */
+static inline void ds_link_list_init(ds_link_list * list)
+{
+    ds_link_init(&list->head);
+    list->count = 0;
+}
+
+/**
+ *  get list->count
+ */
+static inline ds_size ds_link_list_length(const ds_link_list * list)
+{
+    return list->count;
+}
+
+/**
+ *  check list->count == 0
+ */
+static inline ds_bool ds_link_list_empty(const ds_link_list * list)
+{
+    return list->head.next == &list->head;
+}
+
+/**
+ *  get the first link, or NULL when the list is empty
+ */
+static inline ds_link * ds_link_list_first(const ds_link_list * list)
+{
+    return list->head.next == &list->head ? NULL : list->head.next;
+}
+
+/**
+ *  get the last link, or NULL when the list is empty
+ */
+static inline ds_link * ds_link_list_last(const ds_link_list * list)
+{
+    return list->head.prev == &list->head ? NULL : list->head.prev;
+}
+
+/**
+ *  insert the link after the position, if (pos == NULL) then insert as head
+ */
+static inline void ds_link_list_insert(ds_link_list * list, ds_link * pos, ds_link * link)
+{
+    ds_link * prev = pos ? pos : &list->head;
+    link->prev = prev;
+    link->next = prev->next;
+    prev->next->prev = link;
+    prev->next = link;
+    list->count += 1;
+}
+
+/**
+ *  insert the link before the position, if (pos == NULL) then insert as tail
+ */
+static inline void ds_link_list_insert_before(ds_link_list * list, ds_link * pos, ds_link * link)
+{
+    ds_link_list_insert(list, pos ? pos->prev : list->head.prev, link);
+}
+
+/**
+ *  append the link to the tail
+ */
+static inline void ds_link_list_append(ds_link_list * list, ds_link * link)
+{
+    ds_link_list_insert(list, list->head.prev, link);
+}
+
+/**
+ *  remove the link from the list in O(1), it will be set as not linked
+ */
+static inline void ds_link_list_remove(ds_link_list * list, ds_link * link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    ds_link_init(link);
+    list->count -= 1;
+}
+
+/**
+ *  remove the first link and return it, or NULL when the list is empty
+ */
+static inline ds_link * ds_link_list_shift(ds_link_list * list)
+{
+    ds_link * link = ds_link_list_first(list);
+    if (link) {
+        ds_link_list_remove(list, link);
+    }
+    return link;
+}
+
+/**
+ *  remove the last link and return it, or NULL when the list is empty
+ */
+static inline ds_link * ds_link_list_pop(ds_link_list * list)
+{
+    ds_link * link = ds_link_list_last(list);
+    if (link) {
+        ds_link_list_remove(list, link);
+    }
+    return link;
+}
+
+/**
+ *  move all links of the other list to the tail of this list in O(1)
+ */
+static inline void ds_link_list_splice(ds_link_list * list, ds_link_list * other)
+{
+    if (ds_link_list_empty(other)) {
+        return;
+    }
+    ds_link * first = other->head.next;
+    ds_link * last = other->head.prev;
+    first->prev = list->head.prev;
+    list->head.prev->next = first;
+    last->next = &list->head;
+    list->head.prev = last;
+    list->count += other->count;
+    ds_link_list_init(other);
+}
+
+#pragma mark - Queue base on ds_link_list
+
+typedef ds_link_list    ds_link_queue;
+
+#define ds_link_queue_init(queue)          ds_link_list_init(queue)
+
+#define ds_link_queue_length(queue)        ds_link_list_length(queue)
+
+#define ds_link_queue_empty(queue)         ds_link_list_empty(queue)
+
+/**
+ *  append the link to tail of the queue
+ */
+#define ds_link_queue_push(queue, link)    ds_link_list_append(queue, link)
+
+/**
+ *  remove head link from the queue and return it
+ */
+#define ds_link_queue_shift(queue)         ds_link_list_shift(queue)
+
+#pragma mark - Stack base on ds_link_list
+
+typedef ds_link_list    ds_link_stack;
+
+#define ds_link_stack_init(stack)          ds_link_list_init(stack)
+
+#define ds_link_stack_length(stack)        ds_link_list_length(stack)
+
+#define ds_link_stack_empty(stack)         ds_link_list_empty(stack)
+
+/**
+ *  add link to top of the stack (list head)
+ */
+#define ds_link_stack_push(stack, link)    ds_link_list_insert(stack, NULL, link)
+
+/**
+ *  remove top link from the stack and return it
+ */
+#define ds_link_stack_pop(stack)           ds_link_list_shift(stack)
+
+/**
+ *  get top link (not removed)
+ */
+#define ds_link_stack_top(stack)           ds_link_list_first(stack)
+
+#endif /* defined(__ds_link__) */
@@ -0,0 +1,212 @@
+//
+//  ds_mpmc_queue.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sched.h>
+
+#include "ds_mpmc_queue.h"
+
+#define DS_MPMC_SPIN_COUNT  64
+
+static inline _Atomic(size_t) * _mpmc_queue_seq(const ds_mpmc_queue * queue, const size_t pos)
+{
+    return (_Atomic(size_t) *)(queue->slots + (pos & queue->mask) * queue->slot_size);
+}
+
+static inline ds_data * _mpmc_queue_item(const ds_mpmc_queue * queue, const size_t pos)
+{
+    // the item is stored right after the sequence
+    return (ds_data *)(_mpmc_queue_seq(queue, pos) + 1);
+}
+
+static inline void _mpmc_queue_assign(const ds_mpmc_queue * queue,
+                                      ds_data * dest, const ds_data src)
+{
+    if (queue->fn.assign) {
+	    queue->fn.assign(dest, src, queue->item_size);
+    } else if (queue->bk.assign) {
+	    queue->bk.assign(dest, src, queue->item_size);
+    } else {
+	    memcpy(dest, &src, queue->item_size);
+    }
+}
+
+static inline void _mpmc_queue_backoff(unsigned int * spins)
+{
+    if (++(*spins) > DS_MPMC_SPIN_COUNT) {
+        sched_yield();
+    }
+}
+
+// claim at most 'count' ready positions from the counter (turn: 0 to push, 1 to pop),
+// return count of the claimed positions starting from '*start'
+static inline size_t _mpmc_queue_claim(ds_mpmc_queue * queue, _Atomic(size_t) * counter,
+                                       const size_t turn, const size_t count, size_t * start)
+{
+    size_t pos = atomic_load_explicit(counter, memory_order_relaxed);
+    size_t seq, n;
+    intptr_t diff;
+    for (;;) {
+        // count the ready slots from 'pos'
+        for (n = 0; n < count; ++n) {
+            seq = atomic_load_explicit(_mpmc_queue_seq(queue, pos + n), memory_order_acquire);
+            if (seq != pos + n + turn) {
+                break;
+            }
+        }
+        if (n == 0) {
+            diff = (intptr_t)seq - (intptr_t)(pos + turn);
+            if (diff < 0) {
+                // full for pushing, or empty for popping
+                return 0;
+            }
+            // claimed by another thread, try next position
+            pos = atomic_load_explicit(counter, memory_order_relaxed);
+        } else if (atomic_compare_exchange_weak_explicit(counter, &pos, pos + n,
+                                                         memory_order_relaxed,
+                                                         memory_order_relaxed)) {
+            *start = pos;
+            return n;
+        }
+    }
+}
+
+#pragma mark -
+
+ds_mpmc_queue * ds_mpmc_queue_create(const ds_size item_size,
+                                     const ds_size capacity)
+{
+    // aligned to cache line for the padded head/tail
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_mpmc_queue)) != 0) {
+        return NULL;
+    }
+    ds_mpmc_queue * queue = (ds_mpmc_queue *)ptr;
+    memset(queue, 0, sizeof(ds_mpmc_queue));
+    size_t size = 2;
+    while (size < (size_t)capacity) {
+        size <<= 1;
+    }
+    queue->capacity = size;
+    queue->mask = size - 1;
+    queue->item_size = item_size > 0 ? item_size : (ds_size)sizeof(ds_data);
+    queue->slot_size = sizeof(size_t) + queue->item_size;
+    queue->slot_size = (queue->slot_size + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, size * queue->slot_size) != 0) {
+        free(queue);
+        return NULL;
+    }
+    queue->slots = (ds_byte *)ptr;
+    // slot 'pos' is free for the producer of position 'pos'
+    for (size_t pos = 0; pos < size; ++pos) {
+        atomic_init(_mpmc_queue_seq(queue, pos), pos);
+    }
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    return queue;
+}
+
+void ds_mpmc_queue_destroy(ds_mpmc_queue * queue)
+{
+    free(queue->slots);
+    queue->slots = NULL;
+    free(queue);
+}
+
+ds_size ds_mpmc_queue_length(ds_mpmc_queue * queue)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    // claimed positions, not all of them are finished
+    return tail > head ? (ds_size)(tail - head) : 0;
+}
+
+ds_bool ds_mpmc_queue_empty(ds_mpmc_queue * queue)
+{
+    return ds_mpmc_queue_length(queue) == 0;
+}
+
+#pragma mark Non-blocking
+
+ds_bool ds_mpmc_queue_try_push(ds_mpmc_queue * queue, const ds_data item)
+{
+    size_t pos;
+    if (_mpmc_queue_claim(queue, &queue->tail, 0, 1, &pos) == 0) {
+        return DSFalse;
+    }
+    _mpmc_queue_assign(queue, _mpmc_queue_item(queue, pos), item);
+    // filled, hand it to the consumer
+    atomic_store_explicit(_mpmc_queue_seq(queue, pos), pos + 1, memory_order_release);
+    return DSTrue;
+}
+
+ds_bool ds_mpmc_queue_try_pop(ds_mpmc_queue * queue, ds_data * item)
+{
+    size_t pos;
+    if (_mpmc_queue_claim(queue, &queue->head, 1, 1, &pos) == 0) {
+        return DSFalse;
+    }
+    memcpy(item, _mpmc_queue_item(queue, pos), queue->item_size);
+    // emptied, hand it to the producer of next round
+    atomic_store_explicit(_mpmc_queue_seq(queue, pos), pos + queue->capacity,
+                          memory_order_release);
+    return DSTrue;
+}
+
+ds_size ds_mpmc_queue_try_push_n(ds_mpmc_queue * queue,
+                                 const ds_data * items, const ds_size count)
+{
+    size_t pos, n, i;
+    if (count <= 0) {
+        return 0;
+    }
+    n = _mpmc_queue_claim(queue, &queue->tail, 0, (size_t)count, &pos);
+    for (i = 0; i < n; ++i) {
+        _mpmc_queue_assign(queue, _mpmc_queue_item(queue, pos + i), items[i]);
+        atomic_store_explicit(_mpmc_queue_seq(queue, pos + i), pos + i + 1,
+                              memory_order_release);
+    }
+    return (ds_size)n;
+}
+
+ds_size ds_mpmc_queue_try_pop_n(ds_mpmc_queue * queue,
+                                ds_data * items, const ds_size max)
+{
+    size_t pos, n, i;
+    ds_byte * dest = (ds_byte *)items;
+    if (max <= 0) {
+        return 0;
+    }
+    n = _mpmc_queue_claim(queue, &queue->head, 1, (size_t)max, &pos);
+    for (i = 0; i < n; ++i, dest += queue->item_size) {
+        memcpy(dest, _mpmc_queue_item(queue, pos + i), queue->item_size);
+        atomic_store_explicit(_mpmc_queue_seq(queue, pos + i), pos + i + queue->capacity,
+                              memory_order_release);
+    }
+    return (ds_size)n;
+}
+
+#pragma mark Blocking
+
+void ds_mpmc_queue_push(ds_mpmc_queue * queue, const ds_data item)
+{
+    unsigned int spins = 0;
+    while (!ds_mpmc_queue_try_push(queue, item)) {
+        _mpmc_queue_backoff(&spins);
+    }
+}
+
+void ds_mpmc_queue_pop(ds_mpmc_queue * queue, ds_data * item)
+{
+    unsigned int spins = 0;
+    while (!ds_mpmc_queue_try_pop(queue, item)) {
+        _mpmc_queue_backoff(&spins);
+    }
+}
@@ -0,0 +1,120 @@
+//
+//  ds_mpmc_queue.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_mpmc_queue__
+#define __ds_mpmc_queue__
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "ds_base.h"
+
+//
+//  Bounded multi-producer/multi-consumer queue (Dmitry Vyukov)
+//
+//      Every slot has a sequence number telling whose turn it is: a slot at
+//  position 'pos' is free for the producer when (seq == pos), and is filled
+//  for the consumer when (seq == pos + 1); after popped, the consumer sets
+//  (seq = pos + capacity) for the producer of next round.
+//      Producers/consumers only contend on claiming positions by CAS, and
+//  never wait for each other inside the queue.
+//
+//      The items are copied in with the same 'item_size' and 'assign' hooks
+//  as 'ds_circular_queue', and copied out when popping (item_size bytes),
+//  since the slot may be reused by other threads at once.
+//
+
+typedef struct _ds_mpmc_queue {
+
+    size_t capacity; // power of two
+    size_t mask;     // capacity - 1
+
+    ds_size item_size;
+    size_t slot_size; // sequence + item, aligned
+    ds_byte * slots;
+
+    // functions
+    struct {
+	    ds_assign_func   assign;
+    } fn;
+    // blocks
+    struct {
+	    ds_assign_block  assign;
+    } bk;
+
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(size_t) tail; // next position to push
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(size_t) head; // next position to pop
+} ds_mpmc_queue;
+
+/**
+ *  create a queue struct with item size and capacity (rounded up to power of two)
+ */
+ds_mpmc_queue * ds_mpmc_queue_create(const ds_size item_size,
+                                     const ds_size capacity);
+
+/**
+ *  destroy the queue struct and its items (no other thread is using it)
+ */
+void ds_mpmc_queue_destroy(ds_mpmc_queue * queue);
+
+/**
+ *  get items count (just a snapshot)
+ */
+ds_size ds_mpmc_queue_length(ds_mpmc_queue * queue);
+
+/**
+ *  check whether the queue is empty (just a snapshot)
+ */
+ds_bool ds_mpmc_queue_empty(ds_mpmc_queue * queue);
+
+#pragma mark Non-blocking
+
+/**
+ *  append the item to tail of the queue
+ *
+ * @return DSFalse when the queue is full
+ */
+ds_bool ds_mpmc_queue_try_push(ds_mpmc_queue * queue, const ds_data item);
+
+/**
+ *  remove head item from the queue and copy it into 'item' (item_size bytes)
+ *
+ * @return DSFalse when the queue is empty
+ */
+ds_bool ds_mpmc_queue_try_pop(ds_mpmc_queue * queue, ds_data * item);
+
+/**
+ *  append items to tail of the queue in order, by claiming the free slots at once
+ *
+ * @return count of pushed items, may be less than 'count' when the queue is full
+ */
+ds_size ds_mpmc_queue_try_push_n(ds_mpmc_queue * queue,
+                                 const ds_data * items, const ds_size count);
+
+/**
+ *  remove items from head of the queue, copy them into 'items' one by one
+ *  (item_size bytes for each)
+ *
+ * @return count of popped items, may be less than 'max' when the queue is empty
+ */
+ds_size ds_mpmc_queue_try_pop_n(ds_mpmc_queue * queue,
+                                ds_data * items, const ds_size max);
+
+#pragma mark Blocking
+
+/**
+ *  append the item, spin (and then yield) while the queue is full
+ */
+void ds_mpmc_queue_push(ds_mpmc_queue * queue, const ds_data item);
+
+/**
+ *  remove head item, spin (and then yield) while the queue is empty
+ */
+void ds_mpmc_queue_pop(ds_mpmc_queue * queue, ds_data * item);
+
+#endif /* defined(__ds_mpmc_queue__) */
@@ -54,6 +54,11 @@ void ds_chain_queue_node_destroy(ds_chain_queue_node * node)
     ds_chain_node_destroy(node);
 }
 
+void ds_chain_queue_node_recycle(ds_chain_queue * queue, ds_chain_queue_node * node)
+{
+    ds_chain_node_recycle(queue, node);
+}
+
 ds_chain_queue * ds_chain_queue_copy(const ds_chain_queue * queue,
                                      const ds_size data_size)
 {
@@ -62,6 +67,50 @@ ds_chain_queue * ds_chain_queue_copy(const ds_chain_queue * queue,
 
 #pragma mark - Circular queue base on ds_array
 
+#if DS_CIRCULAR_QUEUE_MASKED
+
+// offset of the counter in the items
+#define _circular_queue_offset(queue, pos)  ((pos) & ((queue)->capacity - 1))
+
+// counters run freely, no wrapping
+#define _circular_queue_move(queue, pos, n) ((pos) + (n))
+
+// all spaces can be used
+#define _circular_queue_room(queue)                                            \
+            ((queue)->capacity - ds_circular_queue_length(queue))
+
+static inline void _circular_queue_expand(ds_circular_queue * queue)
+{
+    ds_size middle = queue->capacity;
+    ds_size head = _circular_queue_offset(queue, queue->head);
+    ds_size count = ds_circular_queue_length(queue);
+    queue->capacity *= 2;
+    queue->items = (ds_data *)realloc(queue->items, queue->capacity * queue->item_size);
+    
+    // rebase the counters to the head offset, so items [head, middle) stay,
+    // and the wrapped part [0, head + count - middle) moves to the new zone
+    if (head + count > middle) {
+	    ds_byte * src = (ds_byte *)queue->items;
+	    ds_byte * dest = src + middle * queue->item_size;
+	    memcpy(dest, src, (head + count - middle) * queue->item_size);
+    }
+    queue->head = head;
+    queue->tail = head + count;
+}
+
+#else
+
+#define _circular_queue_offset(queue, pos)  (pos)
+
+// move the pointer circularly
+#define _circular_queue_move(queue, pos, n)                                    \
+            ((pos) + (n) >= (queue)->capacity ?                                \
+                (pos) + (n) - (queue)->capacity : (pos) + (n))
+
+// ONE space never used
+#define _circular_queue_room(queue)                                            \
+            ((queue)->capacity - ds_circular_queue_length(queue) - 1)
+
 static inline void _circular_queue_expand(ds_circular_queue * queue)
 {
     ds_size middle = queue->capacity;
@@ -85,6 +134,8 @@ static inline void _circular_queue_expand(ds_circular_queue * queue)
     }
 }
 
+#endif
+
 static inline void _circular_queue_assign(const ds_circular_queue * queue,
                                           ds_data * dest, const ds_data src)
 {
@@ -117,6 +168,13 @@ ds_circular_queue * ds_circular_queue_create(const ds_size item_size,
     ds_circular_queue * queue = (ds_circular_queue *)malloc(sizeof(ds_circular_queue));
     memset(queue, 0, sizeof(ds_circular_queue));
     queue->capacity = capacity > 0 ? capacity : 8;
+#if DS_CIRCULAR_QUEUE_MASKED
+    ds_size size = 2;
+    while (size < queue->capacity) {
+        size <<= 1;
+    }
+    queue->capacity = size;
+#endif
     queue->item_size = item_size > 0 ? item_size : sizeof(ds_data);
     queue->items = (ds_data *)calloc(queue->capacity, queue->item_size);
     return queue;
@@ -130,18 +188,14 @@ void ds_circular_queue_destroy(ds_circular_queue * queue)
     free(queue);
 }
 
-ds_size ds_circular_queue_length(const ds_circular_queue * queue)
+ds_size (ds_circular_queue_length)(const ds_circular_queue * queue)
 {
-    if (queue->tail < queue->head) {
-	    return queue->capacity - queue->head + queue->tail;
-    } else {
-	    return queue->tail - queue->head;
-    }
+    return _ds_circular_queue_length(queue);
 }
 
-ds_bool ds_circular_queue_empty(const ds_circular_queue * queue)
+ds_bool (ds_circular_queue_empty)(const ds_circular_queue * queue)
 {
-    return queue->tail == queue->head;
+    return _ds_circular_queue_empty(queue);
 }
 
 void ds_circular_queue_clear(ds_circular_queue * queue)
@@ -152,22 +206,18 @@ void ds_circular_queue_clear(ds_circular_queue * queue)
 
 void ds_circular_queue_push(ds_circular_queue * queue, const ds_data item)
 {
-    ds_size count = ds_circular_queue_length(queue);
-    if (count + 1 >= queue->capacity) {
-	    // only ONE space left, expand the queue
+    if (_circular_queue_room(queue) <= 0) {
+	    // no space left, expand the queue
         _circular_queue_expand(queue);
     }
     
     // append item to tail
     ds_byte * ptr = (ds_byte *)queue->items;
-    ptr += queue->tail * queue->item_size;
+    ptr += _circular_queue_offset(queue, queue->tail) * queue->item_size;
     _circular_queue_assign(queue, (ds_data *)ptr, item);
     
     // move the tail circularly
-    queue->tail += 1;
-    if (queue->tail >= queue->capacity) {
-	    queue->tail = 0;
-    }
+    queue->tail = _circular_queue_move(queue, queue->tail, 1);
 }
 
 ds_data * ds_circular_queue_shift(ds_circular_queue * queue)
@@ -179,18 +229,92 @@ ds_data * ds_circular_queue_shift(ds_circular_queue * queue)
     
     // remove the head item
     ds_byte * ptr = (ds_byte *)queue->items;
-    ptr += queue->head * queue->item_size;
+    ptr += _circular_queue_offset(queue, queue->head) * queue->item_size;
     //_erase(queue, (ds_data *)ptr, queue->item_size);
     
     // circularly
-    queue->head += 1;
-    if (queue->head >= queue->capacity) {
-	    queue->head = 0;
-    }
+    queue->head = _circular_queue_move(queue, queue->head, 1);
     
     return (ds_data *)ptr;
 }
 
+void ds_circular_queue_push_n(ds_circular_queue * queue,
+                              const ds_data * items, const ds_size count)
+{
+    if (count <= 0) {
+        return;
+    }
+    while (_circular_queue_room(queue) < count) {
+        _circular_queue_expand(queue);
+    }
+    
+    // 1. copy to tail of the buffer
+    ds_size tail = _circular_queue_offset(queue, queue->tail);
+    ds_size part1 = queue->capacity - tail;
+    if (part1 > count) {
+        part1 = count;
+    }
+    ds_byte * dest = (ds_byte *)queue->items;
+    memcpy(dest + tail * queue->item_size, items, part1 * queue->item_size);
+    // 2. copy the rest to front of the buffer (wrapped)
+    if (part1 < count) {
+        memcpy(dest, (ds_byte *)items + part1 * queue->item_size,
+               (count - part1) * queue->item_size);
+    }
+    
+    // move the tail circularly
+    queue->tail = _circular_queue_move(queue, queue->tail, count);
+}
+
+ds_size ds_circular_queue_shift_n(ds_circular_queue * queue,
+                                  ds_data * items, const ds_size max)
+{
+    ds_size count = ds_circular_queue_length(queue);
+    if (count > max) {
+        count = max;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+    
+    if (items) {
+        // 1. copy from head to end of the buffer
+        ds_size head = _circular_queue_offset(queue, queue->head);
+        ds_size part1 = queue->capacity - head;
+        if (part1 > count) {
+            part1 = count;
+        }
+        ds_byte * src = (ds_byte *)queue->items;
+        memcpy(items, src + head * queue->item_size, part1 * queue->item_size);
+        // 2. copy the rest from front of the buffer (wrapped)
+        if (part1 < count) {
+            memcpy((ds_byte *)items + part1 * queue->item_size, src,
+                   (count - part1) * queue->item_size);
+        }
+    }
+    
+    // move the head circularly
+    queue->head = _circular_queue_move(queue, queue->head, count);
+    return count;
+}
+
+ds_size ds_circular_queue_peek(const ds_circular_queue * queue,
+                               ds_circular_queue_span spans[2])
+{
+    ds_size head = _circular_queue_offset(queue, queue->head);
+    ds_size count = ds_circular_queue_length(queue);
+    ds_byte * ptr = (ds_byte *)queue->items;
+    spans[0].items = (ds_data *)(ptr + head * queue->item_size);
+    spans[0].count = queue->capacity - head;
+    if (spans[0].count > count) {
+        spans[0].count = count;
+    }
+    // wrapped part
+    spans[1].items = queue->items;
+    spans[1].count = count - spans[0].count;
+    return count;
+}
+
 ds_circular_queue * ds_circular_queue_copy(const ds_circular_queue * queue)
 {
     ds_size capacity = ds_circular_queue_length(queue) + 1;
@@ -210,6 +334,204 @@ ds_circular_queue * ds_circular_queue_copy(const ds_circular_queue * queue)
     return new_queue;
 }
 
+#pragma mark - Queue base on ds_unrolled_chain
+
+ds_unrolled_queue * ds_unrolled_queue_create(const ds_size item_size,
+                                             const ds_size node_capacity)
+{
+    return ds_unrolled_chain_create(item_size, node_capacity);
+}
+
+void ds_unrolled_queue_destroy(ds_unrolled_queue * queue)
+{
+    ds_unrolled_chain_destroy(queue);
+}
+
+ds_size ds_unrolled_queue_length(const ds_unrolled_queue * queue)
+{
+    return ds_unrolled_chain_length(queue);
+}
+
+ds_bool ds_unrolled_queue_empty(const ds_unrolled_queue * queue)
+{
+    return ds_unrolled_chain_empty(queue);
+}
+
+void ds_unrolled_queue_clear(ds_unrolled_queue * queue)
+{
+    ds_unrolled_chain_clear(queue);
+}
+
+void ds_unrolled_queue_push(ds_unrolled_queue * queue, const ds_data item)
+{
+    ds_unrolled_chain_append(queue, item);
+}
+
+ds_data * ds_unrolled_queue_shift(ds_unrolled_queue * queue)
+{
+    return ds_unrolled_chain_shift(queue);
+}
+
+ds_unrolled_queue * ds_unrolled_queue_copy(const ds_unrolled_queue * queue)
+{
+    return ds_unrolled_chain_copy(queue);
+}
+
+#pragma mark - Segmented queue
+
+#define _segment_item(queue, block, index)                                     \
+            ((ds_data *)((ds_byte *)((block) + 1) + (index) * (queue)->item_size))
+
+static inline void _segmented_queue_assign(const ds_segmented_queue * queue,
+                                           ds_data * dest, const ds_data src)
+{
+    if (queue->fn.assign) {
+	    queue->fn.assign(dest, src, queue->item_size);
+    } else if (queue->bk.assign) {
+	    queue->bk.assign(dest, src, queue->item_size);
+    } else {
+	    memcpy(dest, &src, queue->item_size);
+    }
+}
+
+static inline ds_segment * _segment_alloc(ds_segmented_queue * queue)
+{
+    ds_segment * block = queue->cache;
+    if (block) {
+        queue->cache = block->next;
+        queue->cache_count -= 1;
+    } else {
+        block = (ds_segment *)malloc(sizeof(ds_segment) +
+                                     queue->block_capacity * queue->item_size);
+    }
+    block->next = NULL;
+    return block;
+}
+
+static inline void _segment_recycle(ds_segmented_queue * queue, ds_segment * block)
+{
+    if (queue->cache_count < queue->cache_capacity) {
+        block->next = queue->cache;
+        queue->cache = block;
+        queue->cache_count += 1;
+    } else {
+        // cache is full, give it back
+        free(block);
+    }
+}
+
+static inline void _segment_free_all(ds_segment * block)
+{
+    for (ds_segment * next; block; block = next) {
+        next = block->next;
+        free(block);
+    }
+}
+
+#pragma mark -
+
+ds_segmented_queue * ds_segmented_queue_create(const ds_size item_size,
+                                               const ds_size block_capacity)
+{
+    ds_segmented_queue * queue = (ds_segmented_queue *)malloc(sizeof(ds_segmented_queue));
+    memset(queue, 0, sizeof(ds_segmented_queue));
+    queue->item_size = item_size > 0 ? item_size : (ds_size)sizeof(ds_data);
+    queue->block_capacity = block_capacity > 0 ? block_capacity : 256;
+    queue->cache_capacity = DS_SEGMENTED_QUEUE_CACHE_CAPACITY;
+    queue->head = _segment_alloc(queue);
+    queue->tail = queue->head;
+    return queue;
+}
+
+void ds_segmented_queue_destroy(ds_segmented_queue * queue)
+{
+    _segment_free_all(queue->head);
+    queue->head = NULL;
+    queue->tail = NULL;
+    _segment_free_all(queue->cache);
+    queue->cache = NULL;
+    free(queue);
+}
+
+ds_size ds_segmented_queue_length(const ds_segmented_queue * queue)
+{
+    return queue->count;
+}
+
+ds_bool ds_segmented_queue_empty(const ds_segmented_queue * queue)
+{
+    return queue->count == 0;
+}
+
+void ds_segmented_queue_clear(ds_segmented_queue * queue)
+{
+    ds_segment * block = queue->head->next;
+    for (ds_segment * next; block; block = next) {
+        next = block->next;
+        _segment_recycle(queue, block);
+    }
+    queue->head->next = NULL;
+    queue->tail = queue->head;
+    queue->head_offset = 0;
+    queue->tail_offset = 0;
+    queue->count = 0;
+}
+
+void ds_segmented_queue_trim(ds_segmented_queue * queue)
+{
+    _segment_free_all(queue->cache);
+    queue->cache = NULL;
+    queue->cache_count = 0;
+}
+
+void ds_segmented_queue_push(ds_segmented_queue * queue, const ds_data item)
+{
+    if (queue->count == 0) {
+        // empty, rewind the head block
+        ds_segmented_queue_clear(queue);
+    } else if (queue->tail_offset == queue->block_capacity) {
+        // tail block is full, link a new one
+        ds_segment * block = _segment_alloc(queue);
+        queue->tail->next = block;
+        queue->tail = block;
+        queue->tail_offset = 0;
+    }
+    ds_data * dest = _segment_item(queue, queue->tail, queue->tail_offset);
+    _segmented_queue_assign(queue, dest, item);
+    queue->tail_offset += 1;
+    queue->count += 1;
+}
+
+ds_data * ds_segmented_queue_shift(ds_segmented_queue * queue)
+{
+    if (queue->count == 0) {
+        // empty queue
+        return NULL;
+    }
+    if (queue->head_offset == queue->block_capacity) {
+        // head block was drained by last shift, recycle it now
+        ds_segment * block = queue->head;
+        queue->head = block->next;
+        queue->head_offset = 0;
+        _segment_recycle(queue, block);
+    }
+    ds_data * item = _segment_item(queue, queue->head, queue->head_offset);
+    queue->head_offset += 1;
+    queue->count -= 1;
+    return item;
+}
+
+ds_data * ds_segmented_queue_front(const ds_segmented_queue * queue)
+{
+    if (queue->count == 0) {
+        return NULL;
+    } else if (queue->head_offset == queue->block_capacity) {
+        return _segment_item(queue, queue->head->next, 0);
+    } else {
+        return _segment_item(queue, queue->head, queue->head_offset);
+    }
+}
+
 #pragma mark - Default queue
 
 ds_queue * ds_queue_create(const ds_size item_size,
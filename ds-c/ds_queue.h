@@ -10,6 +10,7 @@
 #define __ds_queue__
 
 #include "ds_chain.h"
+#include "ds_unrolled_chain.h"
 
 #pragma mark Queue base on ds_chain_table
 
@@ -58,6 +59,11 @@ ds_chain_queue_node * ds_chain_queue_shift(ds_chain_queue * queue);
  */
 void ds_chain_queue_node_destroy(ds_chain_queue_node * node);
 
+/**
+ *  give back the node (removed from the queue already) to reuse it by next push
+ */
+void ds_chain_queue_node_recycle(ds_chain_queue * queue, ds_chain_queue_node * node);
+
 /**
  *  copy the queue
  */
@@ -66,6 +72,35 @@ ds_chain_queue * ds_chain_queue_copy(const ds_chain_queue * queue,
 
 #pragma mark - Circular queue base on ds_array
 
+//
+//  Masked mode
+//
+//      When 'DS_CIRCULAR_QUEUE_MASKED' is set (off by default, define it as 1
+//  in the build settings to opt in), the capacity is rounded up to a power
+//  of two, head/tail are free-running counters which are masked when
+//  accessing the items, so all spaces can be used, the length is just
+//  (tail - head), and no branch is needed for wrapping around.
+//
+#ifndef DS_CIRCULAR_QUEUE_MASKED
+#define DS_CIRCULAR_QUEUE_MASKED 0
+#endif
+
+#if DS_CIRCULAR_QUEUE_MASKED
+
+typedef unsigned int    ds_circular_queue_pos;
+
+#define ds_circular_queue_at(queue, index)                                     \
+    ({                                                                         \
+        ds_byte * __ptr = (ds_byte *)((queue)->items);                         \
+        (ds_data *)(__ptr + (queue)->item_size *                               \
+            (((queue)->head + (index)) & ((queue)->capacity - 1)));            \
+    })                                                                         \
+                                                /* EOF 'ds_circular_queue_at' */
+
+#else
+
+typedef ds_size         ds_circular_queue_pos;
+
 #define ds_circular_queue_at(queue, index)                                     \
     ({                                                                         \
         ds_byte * __ptr = (ds_byte *)((queue)->items);                         \
@@ -76,15 +111,17 @@ ds_chain_queue * ds_chain_queue_copy(const ds_chain_queue * queue,
     })                                                                         \
                                                 /* EOF 'ds_circular_queue_at' */
 
+#endif
+
 #define DS_CIRCULAR_QUEUE_FOR_EACH_ITEM(queue, item, index)                    \
     for ((index) = 0;                                                          \
          (item) = (__typeof__(item))ds_circular_queue_at(queue, index),        \
-             (index) < ds_circular_queue_length(queue);                                 \
+             (index) < ds_circular_queue_length(queue);                        \
          ++(index))                                                            \
                                      /* EOF 'DS_CIRCULAR_QUEUE_FOR_EACH_ITEM' */
 
-#define DS_CIRCULAR_QUEUE_FOR_EACH_ITEM_REVERSE(array, item, index)            \
-    for ((index) = ds_circular_queue_length(queue);                                     \
+#define DS_CIRCULAR_QUEUE_FOR_EACH_ITEM_REVERSE(queue, item, index)            \
+    for ((index) = ds_circular_queue_length(queue);                            \
          (item) = (__typeof__(item))ds_circular_queue_at(queue, (index) - 1),  \
              (index)-- > 0;                                                    \
          )                                                                     \
@@ -96,12 +133,12 @@ ds_chain_queue * ds_chain_queue_copy(const ds_chain_queue * queue,
 //         so please don't access it as an array.
 //      2. For circularly algorithm needs, there is ONE space(s) never be used
 //         in the 'queue->items', so 'ds_circular_queue_length(queue)' will always smaller
-//         than the 'queue->capacity'
+//         than the 'queue->capacity' (except in masked mode)
 //
 typedef struct _ds_circular_queue {
     
-    ds_size capacity; // max length of items (ONE item space never used)
-    ds_size head, tail; // offsets for head/tail pointer
+    ds_size capacity; // max length of items (ONE item space never used, or power of two)
+    ds_circular_queue_pos head, tail; // offsets for head/tail pointer (or counters)
 
     ds_size item_size;
     ds_data * items;
@@ -120,8 +157,15 @@ typedef struct _ds_circular_queue {
 
 typedef ds_data         ds_circular_queue_node;
 
+// contiguous items in the queue buffer
+typedef struct _ds_circular_queue_span {
+    ds_circular_queue_node * items;
+    ds_size count;
+} ds_circular_queue_span;
+
 /**
  *  create a queue struct with item size and capacity
+ *  (rounded up to power of two in masked mode)
  */
 ds_circular_queue * ds_circular_queue_create(const ds_size item_size,
                                              const ds_size capacity);
@@ -156,12 +200,203 @@ void ds_circular_queue_push(ds_circular_queue * queue, const ds_data item);
  */
 ds_circular_queue_node * ds_circular_queue_shift(ds_circular_queue * queue);
 
+/**
+ *  append items (item_size bytes for each) to tail of the queue by memcpy,
+ *  at most two copies around the end of buffer (assign hooks are not called)
+ */
+void ds_circular_queue_push_n(ds_circular_queue * queue,
+                              const ds_data * items, const ds_size count);
+
+/**
+ *  remove at most 'max' items from head of the queue, copy them into 'items'
+ *  (item_size bytes for each), or just drop them if 'items' is NULL
+ *
+ * @return count of removed items
+ */
+ds_size ds_circular_queue_shift_n(ds_circular_queue * queue,
+                                  ds_data * items, const ds_size max);
+
+/**
+ *  get all items in place without removing them, as one or two contiguous spans
+ *  (the second one is empty if not wrapped), remove them by shift_n(queue, NULL, n)
+ *
+ * @return count of items in the spans
+ */
+ds_size ds_circular_queue_peek(const ds_circular_queue * queue,
+                               ds_circular_queue_span spans[2]);
+
 /**
  *  copy the queue, the new_queue->capacity = ds_circular_queue_length(queue) + 1
+ *              (rounded up to power of two in masked mode)
  *              the new_queue->head = 0
  */
 ds_circular_queue * ds_circular_queue_copy(const ds_circular_queue * queue);
 
+static inline ds_size _ds_circular_queue_length(const ds_circular_queue * queue)
+{
+#if DS_CIRCULAR_QUEUE_MASKED
+    return (ds_size)(queue->tail - queue->head);
+#else
+    if (queue->tail < queue->head) {
+	    return queue->capacity - queue->head + queue->tail;
+    } else {
+	    return queue->tail - queue->head;
+    }
+#endif
+}
+
+static inline ds_bool _ds_circular_queue_empty(const ds_circular_queue * queue)
+{
+    return queue->tail == queue->head;
+}
+
+#if DS_INLINE
+#define ds_circular_queue_length(queue)  _ds_circular_queue_length(queue)
+#define ds_circular_queue_empty(queue)   _ds_circular_queue_empty(queue)
+#endif
+
+#pragma mark - Queue base on ds_unrolled_chain
+
+typedef ds_data            ds_unrolled_queue_node;
+typedef ds_unrolled_chain  ds_unrolled_queue;
+
+/**
+ *  create a queue struct with item size and max count of items in each node
+ */
+ds_unrolled_queue * ds_unrolled_queue_create(const ds_size item_size,
+                                             const ds_size node_capacity);
+
+/**
+ *  destroy the queue struct and its items
+ */
+void ds_unrolled_queue_destroy(ds_unrolled_queue * queue);
+
+/**
+ *  get items count
+ */
+ds_size ds_unrolled_queue_length(const ds_unrolled_queue * queue);
+
+/**
+ *  check whether the queue is empty
+ */
+ds_bool ds_unrolled_queue_empty(const ds_unrolled_queue * queue);
+
+/**
+ *  clear the queue
+ */
+void ds_unrolled_queue_clear(ds_unrolled_queue * queue);
+
+/**
+ *  append the item data to tail of the queue
+ */
+void ds_unrolled_queue_push(ds_unrolled_queue * queue, const ds_data item);
+
+/**
+ *  remove head item from the queue and return it (but NOT erase),
+ *  the item is valid until next push
+ */
+ds_unrolled_queue_node * ds_unrolled_queue_shift(ds_unrolled_queue * queue);
+
+/**
+ *  copy the queue
+ */
+ds_unrolled_queue * ds_unrolled_queue_copy(const ds_unrolled_queue * queue);
+
+#pragma mark - Segmented queue
+
+//
+//      Items are stored in fixed-size blocks linked from head to tail, so
+//  growing just links a new block, nothing is copied; a drained block goes
+//  to a small cache for reusing, or is freed when the cache is full, so the
+//  memory shrinks after bursts. Push and shift are O(1) in the worst case.
+//
+
+#ifndef DS_SEGMENTED_QUEUE_CACHE_CAPACITY
+#define DS_SEGMENTED_QUEUE_CACHE_CAPACITY 4
+#endif
+
+// items are stored right after the block
+typedef struct _ds_segment {
+    struct _ds_segment * next;
+} ds_segment;
+
+typedef struct _ds_segmented_queue {
+
+    ds_segment * head; // block for shifting
+    ds_segment * tail; // block for pushing
+    ds_size head_offset; // index of next item to shift in head block
+    ds_size tail_offset; // index of next space to push in tail block
+    ds_size count;
+
+    ds_size item_size;
+    ds_size block_capacity; // max count of items in each block
+
+    // drained blocks for reusing
+    ds_segment * cache;
+    ds_size cache_count;
+    ds_size cache_capacity;
+
+    // functions
+    struct {
+	    ds_assign_func   assign;
+	    ds_erase_func    erase;
+    } fn;
+    // blocks
+    struct {
+	    ds_assign_block  assign;
+	    ds_erase_block   erase;
+    } bk;
+} ds_segmented_queue;
+
+typedef ds_data         ds_segmented_queue_node;
+
+/**
+ *  create a queue struct with item size and max count of items in each block
+ */
+ds_segmented_queue * ds_segmented_queue_create(const ds_size item_size,
+                                               const ds_size block_capacity);
+
+/**
+ *  destroy the queue struct, its items and blocks
+ */
+void ds_segmented_queue_destroy(ds_segmented_queue * queue);
+
+/**
+ *  get items count
+ */
+ds_size ds_segmented_queue_length(const ds_segmented_queue * queue);
+
+/**
+ *  check whether the queue is empty
+ */
+ds_bool ds_segmented_queue_empty(const ds_segmented_queue * queue);
+
+/**
+ *  clear the queue, keep one block (and the cache)
+ */
+void ds_segmented_queue_clear(ds_segmented_queue * queue);
+
+/**
+ *  free all the cached blocks
+ */
+void ds_segmented_queue_trim(ds_segmented_queue * queue);
+
+/**
+ *  append the item data to tail of the queue
+ */
+void ds_segmented_queue_push(ds_segmented_queue * queue, const ds_data item);
+
+/**
+ *  remove head item from the queue and return it (but NOT erase),
+ *  the item is valid until next push or shift
+ */
+ds_segmented_queue_node * ds_segmented_queue_shift(ds_segmented_queue * queue);
+
+/**
+ *  get head item (not removed), or NULL when the queue is empty
+ */
+ds_segmented_queue_node * ds_segmented_queue_front(const ds_segmented_queue * queue);
+
 #pragma mark - Default queue
 
 typedef ds_circular_queue_node ds_queue_node;
@@ -0,0 +1,454 @@
+//
+//  ds_skiplist.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_skiplist.h"
+
+#define DS_MARK            ((uintptr_t)1)
+#define DS_PTR(ref)        ((ds_skiplist_node *)((ref) & ~DS_MARK))
+#define DS_MARKED(ref)     (((ref) & DS_MARK) != 0)
+#define DS_REF(node)       ((uintptr_t)(node))
+
+#define DS_NEXT(node, lv)  atomic_load(&(node)->next[lv])
+
+static inline ds_bool _skiplist_cas(ds_skiplist_node * node, const ds_size lv,
+                                    uintptr_t expected, const uintptr_t desired)
+{
+    return atomic_compare_exchange_strong(&node->next[lv], &expected, desired);
+}
+
+static inline ds_comparison_result _skiplist_compare(const ds_skiplist * list,
+                                                     const ds_data left,
+                                                     const ds_data right)
+{
+    if (list->fn.compare) {
+        return list->fn.compare(left, right);
+    } else if (list->bk.compare) {
+        return list->bk.compare(left, right);
+    } else if (left < right) {
+        return DSAscending;
+    } else if (left > right) {
+        return DSDescending;
+    } else {
+        return DSSame;
+    }
+}
+
+static inline ds_size _skiplist_random_level(void)
+{
+    // xorshift, one seed per thread
+    static _Thread_local uint32_t seed = 0;
+    if (seed == 0) {
+        seed = (uint32_t)(uintptr_t)&seed | 1;
+    }
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    // p = 1/4
+    ds_size level = 1;
+    for (uint32_t bits = seed; (bits & 3) == 0 && level < DS_SKIPLIST_MAX_LEVEL; bits >>= 2) {
+        ++level;
+    }
+    return level;
+}
+
+static inline ds_skiplist_node * _skiplist_create_node(const ds_size level,
+                                                       const ds_data key,
+                                                       const ds_data value)
+{
+    size_t len = sizeof(ds_skiplist_node) + level * sizeof(_Atomic(uintptr_t));
+    ds_skiplist_node * node = (ds_skiplist_node *)malloc(len);
+    node->key = key;
+    node->value = value;
+    node->level = level;
+    atomic_init(&node->refs, 2);
+    node->retired_next = NULL;
+    for (ds_size lv = 0; lv < level; ++lv) {
+        atomic_init(&node->next[lv], 0);
+    }
+    return node;
+}
+
+#pragma mark Grace period
+
+//
+//      Each operation registers itself as a reader of current epoch. Nodes
+//  retired in epoch 'e' were unlinked before the epoch changed to 'e + 1',
+//  so they can only be seen by the readers registered in epoch 'e' or before;
+//  when epoch is 'e + 1' and no reader left in slot of 'e', they can be freed.
+//
+
+static inline uintptr_t _skiplist_enter(ds_skiplist * list)
+{
+    uintptr_t epoch;
+    for (;;) {
+        epoch = atomic_load(&list->epoch);
+        atomic_fetch_add(&list->readers[epoch & 1], 1);
+        if (atomic_load(&list->epoch) == epoch) {
+            return epoch;
+        }
+        // epoch changed, register again
+        atomic_fetch_sub(&list->readers[epoch & 1], 1);
+    }
+}
+
+static inline void _skiplist_leave(ds_skiplist * list, const uintptr_t epoch)
+{
+    atomic_fetch_sub(&list->readers[epoch & 1], 1);
+}
+
+static inline void _skiplist_free_nodes(ds_skiplist_node * node)
+{
+    for (ds_skiplist_node * next; node; node = next) {
+        next = node->retired_next;
+        free(node);
+    }
+}
+
+static inline void _skiplist_reclaim(ds_skiplist * list)
+{
+    if (atomic_flag_test_and_set(&list->reclaiming)) {
+        // another thread is reclaiming, no need to wait for it
+        return;
+    }
+    uintptr_t epoch = atomic_load(&list->epoch);
+    uintptr_t prev = (epoch - 1) & 1;
+    if (atomic_load(&list->readers[prev]) == 0) {
+        // no reader may see the nodes retired in previous epoch
+        _skiplist_free_nodes(atomic_exchange(&list->retired[prev], NULL));
+        // next epoch uses the slot just cleaned
+        atomic_store(&list->epoch, epoch + 1);
+    }
+    atomic_flag_clear(&list->reclaiming);
+}
+
+static inline void _skiplist_retire(ds_skiplist * list, ds_skiplist_node * node)
+{
+    // the node is unlinked already, tag it with current epoch
+    uintptr_t epoch = atomic_load(&list->epoch);
+    _Atomic(ds_skiplist_node *) * retired = &list->retired[epoch & 1];
+    ds_skiplist_node * top = atomic_load(retired);
+    do {
+        node->retired_next = top;
+    } while (!atomic_compare_exchange_weak(retired, &top, node));
+    _skiplist_reclaim(list);
+}
+
+static inline void _skiplist_release(ds_skiplist * list, ds_skiplist_node * node)
+{
+    if (atomic_fetch_sub(&node->refs, 1) == 1) {
+        _skiplist_retire(list, node);
+    }
+}
+
+#pragma mark Seeking
+
+// find preds & succs of the key on each level, unlink the marked nodes passed by
+static ds_bool _skiplist_find(ds_skiplist * list, const ds_data key,
+                              ds_skiplist_node ** preds, ds_skiplist_node ** succs)
+{
+    ds_skiplist_node * pred, * curr;
+    uintptr_t ref;
+    int lv;
+retry:
+    pred = list->head;
+    for (lv = DS_SKIPLIST_MAX_LEVEL - 1; lv >= 0; --lv) {
+        curr = DS_PTR(DS_NEXT(pred, lv));
+        while (curr) {
+            ref = DS_NEXT(curr, lv);
+            while (DS_MARKED(ref)) {
+                // curr was removed, unlink it from this level
+                if (!_skiplist_cas(pred, lv, DS_REF(curr), ref & ~DS_MARK)) {
+                    goto retry;
+                }
+                curr = DS_PTR(ref);
+                if (curr == NULL) {
+                    break;
+                }
+                ref = DS_NEXT(curr, lv);
+            }
+            if (curr && _skiplist_compare(list, curr->key, key) < 0) {
+                pred = curr;
+                curr = DS_PTR(ref);
+            } else {
+                break;
+            }
+        }
+        preds[lv] = pred;
+        succs[lv] = curr;
+    }
+    return succs[0] && _skiplist_compare(list, succs[0]->key, key) == 0;
+}
+
+// mark all levels of the node, return DSTrue if this thread marked the bottom level
+static ds_bool _skiplist_mark(ds_skiplist_node * node)
+{
+    uintptr_t ref;
+    for (ds_size lv = node->level - 1; lv > 0; --lv) {
+        ref = DS_NEXT(node, lv);
+        while (!DS_MARKED(ref)) {
+            if (atomic_compare_exchange_weak(&node->next[lv], &ref, ref | DS_MARK)) {
+                break;
+            }
+        }
+    }
+    ref = DS_NEXT(node, 0);
+    while (!DS_MARKED(ref)) {
+        if (atomic_compare_exchange_weak(&node->next[0], &ref, ref | DS_MARK)) {
+            return DSTrue;
+        }
+    }
+    // removed by another thread
+    return DSFalse;
+}
+
+#pragma mark -
+
+ds_skiplist * ds_skiplist_create(void)
+{
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_skiplist)) != 0) {
+        return NULL;
+    }
+    ds_skiplist * list = (ds_skiplist *)ptr;
+    memset(list, 0, sizeof(ds_skiplist));
+    list->head = _skiplist_create_node(DS_SKIPLIST_MAX_LEVEL, 0, 0);
+    atomic_init(&list->count, 0);
+    atomic_init(&list->epoch, 2);
+    atomic_flag_clear(&list->reclaiming);
+    atomic_init(&list->readers[0], 0);
+    atomic_init(&list->readers[1], 0);
+    atomic_init(&list->retired[0], NULL);
+    atomic_init(&list->retired[1], NULL);
+    return list;
+}
+
+void ds_skiplist_destroy(ds_skiplist * list)
+{
+    // 1. free nodes in the list (including the head)
+    ds_skiplist_node * node = list->head;
+    for (ds_skiplist_node * next; node; node = next) {
+        next = DS_PTR(DS_NEXT(node, 0));
+        free(node);
+    }
+    // 2. free retired nodes
+    _skiplist_free_nodes(atomic_load(&list->retired[0]));
+    _skiplist_free_nodes(atomic_load(&list->retired[1]));
+    // 3. free the list struct
+    free(list);
+}
+
+ds_size ds_skiplist_length(ds_skiplist * list)
+{
+    return atomic_load_explicit(&list->count, memory_order_relaxed);
+}
+
+ds_bool ds_skiplist_empty(ds_skiplist * list)
+{
+    uintptr_t epoch = _skiplist_enter(list);
+    ds_skiplist_node * node = DS_PTR(DS_NEXT(list->head, 0));
+    while (node && DS_MARKED(DS_NEXT(node, 0))) {
+        node = DS_PTR(DS_NEXT(node, 0));
+    }
+    _skiplist_leave(list, epoch);
+    return node == NULL;
+}
+
+ds_bool ds_skiplist_insert(ds_skiplist * list, const ds_data key, const ds_data value)
+{
+    ds_skiplist_node * preds[DS_SKIPLIST_MAX_LEVEL];
+    ds_skiplist_node * succs[DS_SKIPLIST_MAX_LEVEL];
+    ds_skiplist_node * node = NULL;
+    ds_size level = _skiplist_random_level();
+    ds_size lv;
+    uintptr_t ref;
+
+    uintptr_t epoch = _skiplist_enter(list);
+    // 1. link the bottom level, the node is in the list after this
+    for (;;) {
+        if (_skiplist_find(list, key, preds, succs)) {
+            // key exists
+            free(node);
+            _skiplist_leave(list, epoch);
+            return DSFalse;
+        }
+        if (node == NULL) {
+            node = _skiplist_create_node(level, key, value);
+        }
+        for (lv = 0; lv < level; ++lv) {
+            atomic_store(&node->next[lv], DS_REF(succs[lv]));
+        }
+        if (_skiplist_cas(preds[0], 0, DS_REF(succs[0]), DS_REF(node))) {
+            break;
+        }
+    }
+    atomic_fetch_add_explicit(&list->count, 1, memory_order_relaxed);
+    // 2. link upper levels, stop when the node is being removed
+    for (lv = 1; lv < level; ++lv) {
+        for (;;) {
+            ref = DS_NEXT(node, lv);
+            if (DS_MARKED(ref)) {
+                goto done;
+            }
+            if (ref != DS_REF(succs[lv]) &&
+                !_skiplist_cas(node, lv, ref, DS_REF(succs[lv]))) {
+                // marked by remover
+                goto done;
+            }
+            if (_skiplist_cas(preds[lv], lv, DS_REF(succs[lv]), DS_REF(node))) {
+                break;
+            }
+            // preds/succs changed, find again
+            _skiplist_find(list, key, preds, succs);
+            if (succs[0] != node) {
+                // removed already
+                goto done;
+            }
+        }
+    }
+done:
+    if (DS_MARKED(DS_NEXT(node, 0))) {
+        // removed while linking, make sure it is unlinked from all levels
+        _skiplist_find(list, key, preds, succs);
+    }
+    _skiplist_release(list, node);
+    _skiplist_leave(list, epoch);
+    return DSTrue;
+}
+
+ds_bool ds_skiplist_remove(ds_skiplist * list, const ds_data key, ds_data * value)
+{
+    ds_skiplist_node * preds[DS_SKIPLIST_MAX_LEVEL];
+    ds_skiplist_node * succs[DS_SKIPLIST_MAX_LEVEL];
+    ds_bool ok = DSFalse;
+
+    uintptr_t epoch = _skiplist_enter(list);
+    if (_skiplist_find(list, key, preds, succs)) {
+        ds_skiplist_node * node = succs[0];
+        if (_skiplist_mark(node)) {
+            if (value) {
+                *value = node->value;
+            }
+            atomic_fetch_sub_explicit(&list->count, 1, memory_order_relaxed);
+            // unlink it
+            _skiplist_find(list, key, preds, succs);
+            _skiplist_release(list, node);
+            ok = DSTrue;
+        }
+    }
+    _skiplist_leave(list, epoch);
+    return ok;
+}
+
+ds_bool ds_skiplist_find(ds_skiplist * list, const ds_data key, ds_data * value)
+{
+    ds_skiplist_node * pred, * curr = NULL;
+    uintptr_t ref;
+    int lv;
+
+    uintptr_t epoch = _skiplist_enter(list);
+    // wait-free searching, skip the marked nodes without unlinking
+    pred = list->head;
+    for (lv = DS_SKIPLIST_MAX_LEVEL - 1; lv >= 0; --lv) {
+        curr = DS_PTR(DS_NEXT(pred, lv));
+        while (curr) {
+            ref = DS_NEXT(curr, lv);
+            if (DS_MARKED(ref)) {
+                curr = DS_PTR(ref);
+            } else if (_skiplist_compare(list, curr->key, key) < 0) {
+                pred = curr;
+                curr = DS_PTR(ref);
+            } else {
+                break;
+            }
+        }
+    }
+    ds_bool ok = curr && _skiplist_compare(list, curr->key, key) == 0;
+    if (ok && value) {
+        *value = curr->value;
+    }
+    _skiplist_leave(list, epoch);
+    return ok;
+}
+
+ds_bool ds_skiplist_pop_min(ds_skiplist * list, ds_data * key, ds_data * value)
+{
+    ds_skiplist_node * preds[DS_SKIPLIST_MAX_LEVEL];
+    ds_skiplist_node * succs[DS_SKIPLIST_MAX_LEVEL];
+    ds_bool ok = DSFalse;
+
+    uintptr_t epoch = _skiplist_enter(list);
+    ds_skiplist_node * node = DS_PTR(DS_NEXT(list->head, 0));
+    for (; node; node = DS_PTR(DS_NEXT(node, 0))) {
+        if (DS_MARKED(DS_NEXT(node, 0))) {
+            // removed already
+            continue;
+        }
+        if (_skiplist_mark(node)) {
+            if (key) {
+                *key = node->key;
+            }
+            if (value) {
+                *value = node->value;
+            }
+            atomic_fetch_sub_explicit(&list->count, 1, memory_order_relaxed);
+            // unlink it
+            _skiplist_find(list, node->key, preds, succs);
+            _skiplist_release(list, node);
+            ok = DSTrue;
+            break;
+        }
+    }
+    _skiplist_leave(list, epoch);
+    return ok;
+}
+
+ds_size ds_skiplist_range(ds_skiplist * list, const ds_data from, const ds_data to,
+                          ds_skiplist_visit_func visit, void * ctx)
+{
+    ds_skiplist_node * pred, * curr = NULL;
+    uintptr_t ref;
+    int lv;
+    ds_size count = 0;
+
+    uintptr_t epoch = _skiplist_enter(list);
+    // 1. seek the first node not less than 'from'
+    pred = list->head;
+    for (lv = DS_SKIPLIST_MAX_LEVEL - 1; lv >= 0; --lv) {
+        curr = DS_PTR(DS_NEXT(pred, lv));
+        while (curr) {
+            ref = DS_NEXT(curr, lv);
+            if (DS_MARKED(ref)) {
+                curr = DS_PTR(ref);
+            } else if (_skiplist_compare(list, curr->key, from) < 0) {
+                pred = curr;
+                curr = DS_PTR(ref);
+            } else {
+                break;
+            }
+        }
+    }
+    // 2. visit the bottom level until 'to'
+    for (; curr; curr = DS_PTR(ref)) {
+        ref = DS_NEXT(curr, 0);
+        if (DS_MARKED(ref)) {
+            continue;
+        }
+        if (_skiplist_compare(list, curr->key, to) > 0) {
+            break;
+        }
+        ++count;
+        if (!visit(curr->key, curr->value, ctx)) {
+            break;
+        }
+    }
+    _skiplist_leave(list, epoch);
+    return count;
+}
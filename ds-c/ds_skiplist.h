@@ -0,0 +1,140 @@
+//
+//  ds_skiplist.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_skiplist__
+#define __ds_skiplist__
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "ds_base.h"
+
+//
+//  Lock-free skip list (Herlihy & Shavit)
+//
+//      An ordered map (key -> value) which can be read and updated by many
+//  threads at the same time without any lock. A node is removed logically by
+//  marking its next pointers (the lowest bit), and then unlinked physically
+//  by any thread passing by.
+//
+//      The removed nodes are retired and freed after a grace period: every
+//  operation is running inside a read section, a retired node will be freed
+//  only when all read sections which may still see it have left, so readers
+//  never block writers, and writers never wait for readers.
+//
+//      Keys are compared by 'fn.compare' or 'bk.compare', or compared as
+//  numbers (ds_data) when no compare function is given; the compare hooks
+//  must be set before sharing the list with other threads.
+//
+
+#define DS_SKIPLIST_MAX_LEVEL  32
+
+typedef struct _ds_skiplist_node {
+
+    ds_data key;
+    ds_data value;
+
+    ds_size level; // count of levels this node linked in
+
+    // insertion & removal both hold a reference,
+    // the one who release it at last will retire the node
+    atomic_int refs;
+
+    struct _ds_skiplist_node * retired_next;
+
+    // next nodes of each level, the lowest bit is the removal mark
+    _Atomic(uintptr_t) next[];
+} ds_skiplist_node;
+
+typedef struct _ds_skiplist {
+
+    ds_skiplist_node * head; // sentinel with max level
+
+    _Atomic(ds_size) count;  // approximate count under concurrency
+
+    // grace period for freeing removed nodes
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(uintptr_t) epoch;
+    atomic_flag reclaiming;
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_long readers[2];
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(ds_skiplist_node *) retired[2];
+
+    // functions
+    struct {
+	    ds_compare_func  compare;
+    } fn;
+    // blocks
+    struct {
+	    ds_compare_block compare;
+    } bk;
+} ds_skiplist;
+
+/**
+ *  Called by range scan for each item
+ *
+ * @return DSFalse to stop scanning
+ */
+typedef ds_bool (*ds_skiplist_visit_func)(const ds_data key, const ds_data value, void * ctx);
+
+/**
+ *  create an empty skip list
+ */
+ds_skiplist * ds_skiplist_create(void);
+
+/**
+ *  destroy the list and free all nodes (no other thread is using it)
+ */
+void ds_skiplist_destroy(ds_skiplist * list);
+
+/**
+ *  get count of items (just a snapshot under concurrency)
+ */
+ds_size ds_skiplist_length(ds_skiplist * list);
+
+/**
+ *  check whether the list is empty (just a snapshot under concurrency)
+ */
+ds_bool ds_skiplist_empty(ds_skiplist * list);
+
+/**
+ *  insert the key with value if the key not exists
+ *
+ * @return DSFalse when the key exists already
+ */
+ds_bool ds_skiplist_insert(ds_skiplist * list, const ds_data key, const ds_data value);
+
+/**
+ *  remove the key, and get its value if 'value' is not NULL
+ *
+ * @return DSFalse when the key not found
+ */
+ds_bool ds_skiplist_remove(ds_skiplist * list, const ds_data key, ds_data * value);
+
+/**
+ *  find the key, and get its value if 'value' is not NULL
+ *
+ * @return DSFalse when the key not found
+ */
+ds_bool ds_skiplist_find(ds_skiplist * list, const ds_data key, ds_data * value);
+
+/**
+ *  remove the item with minimal key, and get its key/value if not NULL
+ *
+ * @return DSFalse when the list is empty
+ */
+ds_bool ds_skiplist_pop_min(ds_skiplist * list, ds_data * key, ds_data * value);
+
+/**
+ *  visit items with keys in range [from, to] by ascending order,
+ *  the items inserted/removed during scanning may or may not be visited
+ *
+ * @return count of visited items
+ */
+ds_size ds_skiplist_range(ds_skiplist * list, const ds_data from, const ds_data to,
+                          ds_skiplist_visit_func visit, void * ctx);
+
+#endif /* defined(__ds_skiplist__) */
@@ -0,0 +1,179 @@
+//
+//  ds_slotmap.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_slotmap.h"
+
+#define _slotmap_handle(generation, pos)                                       \
+            (((ds_slotmap_handle)(generation) << 32) | (ds_slotmap_handle)(pos))
+
+static inline void _slotmap_assign(const ds_slotmap * slotmap,
+                                   ds_data * dest, const ds_data src)
+{
+    if (slotmap->fn.assign) {
+	    slotmap->fn.assign(dest, src, slotmap->item_size);
+    } else if (slotmap->bk.assign) {
+	    slotmap->bk.assign(dest, src, slotmap->item_size);
+    } else {
+	    memcpy(dest, &src, slotmap->item_size);
+    }
+}
+
+static inline void _slotmap_erase(const ds_slotmap * slotmap, ds_data * dest)
+{
+    if (slotmap->fn.erase) {
+	    slotmap->fn.erase(dest, slotmap->item_size);
+    } else if (slotmap->bk.erase) {
+	    slotmap->bk.erase(dest, slotmap->item_size);
+    } else {
+	    bzero(dest, slotmap->item_size);
+    }
+}
+
+static inline void _slotmap_expand(ds_slotmap * slotmap)
+{
+    slotmap->capacity *= 2;
+    slotmap->items = (ds_data *)realloc(slotmap->items, slotmap->capacity * slotmap->item_size);
+    slotmap->owners = (uint32_t *)realloc(slotmap->owners, slotmap->capacity * sizeof(uint32_t));
+}
+
+// take a slot from the freelist, or append a new one
+static inline uint32_t _slotmap_alloc_slot(ds_slotmap * slotmap)
+{
+    uint32_t pos = slotmap->free_head;
+    if (pos != UINT32_MAX) {
+        slotmap->free_head = slotmap->slots[pos].index;
+        return pos;
+    }
+    if (slotmap->slots_count == slotmap->slots_capacity) {
+        slotmap->slots_capacity *= 2;
+        slotmap->slots = (ds_slot *)realloc(slotmap->slots, slotmap->slots_capacity * sizeof(ds_slot));
+    }
+    pos = (uint32_t)slotmap->slots_count++;
+    slotmap->slots[pos].generation = 0;
+    return pos;
+}
+
+// kill the slot and push it into the freelist
+static inline void _slotmap_free_slot(ds_slotmap * slotmap, const uint32_t pos)
+{
+    ds_slot * slot = slotmap->slots + pos;
+    slot->generation += 1; // becomes even
+    slot->index = slotmap->free_head;
+    slotmap->free_head = pos;
+}
+
+#pragma mark -
+
+ds_slotmap * ds_slotmap_create(const ds_size item_size, const ds_size capacity)
+{
+    ds_slotmap * slotmap = (ds_slotmap *)malloc(sizeof(ds_slotmap));
+    memset(slotmap, 0, sizeof(ds_slotmap));
+    slotmap->capacity = capacity > 0 ? capacity : 8;
+    slotmap->item_size = item_size > 0 ? item_size : (ds_size)sizeof(ds_data);
+    slotmap->items = (ds_data *)calloc(slotmap->capacity, slotmap->item_size);
+    slotmap->owners = (uint32_t *)malloc(slotmap->capacity * sizeof(uint32_t));
+    slotmap->slots_capacity = slotmap->capacity;
+    slotmap->slots = (ds_slot *)malloc(slotmap->slots_capacity * sizeof(ds_slot));
+    slotmap->free_head = UINT32_MAX;
+    return slotmap;
+}
+
+void ds_slotmap_destroy(ds_slotmap * slotmap)
+{
+    free(slotmap->items);
+    slotmap->items = NULL;
+    free(slotmap->owners);
+    slotmap->owners = NULL;
+    free(slotmap->slots);
+    slotmap->slots = NULL;
+    free(slotmap);
+}
+
+ds_size (ds_slotmap_length)(const ds_slotmap * slotmap)
+{
+    return _ds_slotmap_length(slotmap);
+}
+
+ds_bool (ds_slotmap_empty)(const ds_slotmap * slotmap)
+{
+    return _ds_slotmap_empty(slotmap);
+}
+
+ds_data * (ds_slotmap_at)(const ds_slotmap * slotmap, const ds_size index)
+{
+    return _ds_slotmap_at(slotmap, index);
+}
+
+ds_data * (ds_slotmap_get)(const ds_slotmap * slotmap, const ds_slotmap_handle handle)
+{
+    return _ds_slotmap_get(slotmap, handle);
+}
+
+ds_slotmap_handle ds_slotmap_handle_at(const ds_slotmap * slotmap, const ds_size index)
+{
+    uint32_t pos = slotmap->owners[index];
+    return _slotmap_handle(slotmap->slots[pos].generation, pos);
+}
+
+ds_bool ds_slotmap_contains(const ds_slotmap * slotmap, const ds_slotmap_handle handle)
+{
+    return ds_slotmap_get(slotmap, handle) ? DSTrue : DSFalse;
+}
+
+ds_slotmap_handle ds_slotmap_insert(ds_slotmap * slotmap, const ds_data item)
+{
+    if (slotmap->count == slotmap->capacity) {
+        _slotmap_expand(slotmap);
+    }
+    uint32_t pos = _slotmap_alloc_slot(slotmap);
+    ds_slot * slot = slotmap->slots + pos;
+    slot->generation += 1; // becomes odd
+    slot->index = (uint32_t)slotmap->count;
+    slotmap->owners[slotmap->count] = pos;
+    _slotmap_assign(slotmap, ds_slotmap_at(slotmap, slotmap->count), item);
+    slotmap->count += 1;
+    return _slotmap_handle(slot->generation, pos);
+}
+
+ds_bool ds_slotmap_remove(ds_slotmap * slotmap, const ds_slotmap_handle handle)
+{
+    ds_data * dest = ds_slotmap_get(slotmap, handle);
+    if (!dest) {
+        // stale handle
+        return DSFalse;
+    }
+    uint32_t pos = (uint32_t)handle;
+    uint32_t index = slotmap->slots[pos].index;
+    _slotmap_erase(slotmap, dest);
+    _slotmap_free_slot(slotmap, pos);
+
+    // move the last item into the hole
+    uint32_t last = (uint32_t)slotmap->count - 1;
+    if (index < last) {
+        memcpy(dest, ds_slotmap_at(slotmap, last), slotmap->item_size);
+        pos = slotmap->owners[last];
+        slotmap->owners[index] = pos;
+        slotmap->slots[pos].index = index;
+    }
+    slotmap->count -= 1;
+    return DSTrue;
+}
+
+void ds_slotmap_clear(ds_slotmap * slotmap)
+{
+    ds_data * item;
+    ds_size index;
+    DS_SLOTMAP_FOR_EACH_ITEM(slotmap, item, index) {
+        _slotmap_erase(slotmap, item);
+        _slotmap_free_slot(slotmap, slotmap->owners[index]);
+    }
+    slotmap->count = 0;
+}
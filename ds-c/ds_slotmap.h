@@ -0,0 +1,171 @@
+//
+//  ds_slotmap.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_slotmap__
+#define __ds_slotmap__
+
+#include <stdint.h>
+
+#include "ds_base.h"
+
+//
+//  Slot map
+//
+//      Items are kept dense in one buffer (removing moves the last item into
+//  the hole), and referred by 64-bit handles: the low 32 bits is the index of
+//  a slot, which points to the position of the item in the dense buffer; the
+//  high 32 bits is the generation of the slot, which is odd while the slot is
+//  alive and increased on removing, so a stale handle will be caught.
+//
+//      Free slots are linked by their 'index' fields (embedded freelist), and
+//  reused by the next inserting; inserting, removing and lookup are all O(1).
+//
+
+typedef uint64_t ds_slotmap_handle;
+
+#define DS_SLOTMAP_NIL       ((ds_slotmap_handle)0)  // never be a valid handle
+
+#define DS_SLOTMAP_FOR_EACH_ITEM(slotmap, item, index)                         \
+    for (ds_byte * __ptr = ((index) = 0, (ds_byte *)(slotmap)->items);         \
+         (item) = (__typeof__(item))__ptr, (index) < (slotmap)->count;         \
+         __ptr += (slotmap)->item_size, ++(index))                             \
+                                            /* EOF 'DS_SLOTMAP_FOR_EACH_ITEM' */
+
+typedef struct _ds_slot {
+    uint32_t index;      // position in items when alive, or next free slot
+    uint32_t generation; // odd: alive, even: free
+} ds_slot;
+
+typedef struct _ds_slotmap {
+
+    // dense items
+    ds_size capacity;
+    ds_size count;
+    ds_size item_size;
+    ds_data * items;
+    uint32_t * owners; // slot index of each item
+
+    // slots
+    ds_size slots_capacity;
+    ds_size slots_count;
+    ds_slot * slots;
+    uint32_t free_head; // first free slot, or UINT32_MAX
+
+    // functions
+    struct {
+	    ds_assign_func   assign;
+	    ds_erase_func    erase;
+    } fn;
+    // blocks
+    struct {
+	    ds_assign_block  assign;
+	    ds_erase_block   erase;
+    } bk;
+} ds_slotmap;
+
+/**
+ *  create a slot map with item size and capacity
+ */
+ds_slotmap * ds_slotmap_create(const ds_size item_size, const ds_size capacity);
+
+/**
+ *  destroy the slot map and its items
+ */
+void ds_slotmap_destroy(ds_slotmap * slotmap);
+
+/**
+ *  get items count
+ */
+ds_size ds_slotmap_length(const ds_slotmap * slotmap);
+
+/**
+ *  check slotmap->count == 0
+ */
+ds_bool ds_slotmap_empty(const ds_slotmap * slotmap);
+
+/**
+ *  get item at the dense position (0 <= index < length), for iterating;
+ *  the position of an item may be changed after removing
+ */
+ds_data * ds_slotmap_at(const ds_slotmap * slotmap, const ds_size index);
+
+/**
+ *  get handle of the item at the dense position
+ */
+ds_slotmap_handle ds_slotmap_handle_at(const ds_slotmap * slotmap, const ds_size index);
+
+/**
+ *  get the item referred by handle, or NULL when removed (stale handle)
+ */
+ds_data * ds_slotmap_get(const ds_slotmap * slotmap, const ds_slotmap_handle handle);
+
+/**
+ *  check whether the handle refers to an alive item
+ */
+ds_bool ds_slotmap_contains(const ds_slotmap * slotmap, const ds_slotmap_handle handle);
+
+/**
+ *  insert the item
+ *
+ * @return handle of the new item
+ */
+ds_slotmap_handle ds_slotmap_insert(ds_slotmap * slotmap, const ds_data item);
+
+/**
+ *  erase the item referred by handle, and move the last item into its place
+ *
+ * @return DSFalse when the handle is stale
+ */
+ds_bool ds_slotmap_remove(ds_slotmap * slotmap, const ds_slotmap_handle handle);
+
+/**
+ *  erase all items, and make all handles stale
+ */
+void ds_slotmap_clear(ds_slotmap * slotmap);
+
+#pragma mark - Inline accessors
+
+static inline ds_size _ds_slotmap_length(const ds_slotmap * slotmap)
+{
+    return slotmap->count;
+}
+
+static inline ds_bool _ds_slotmap_empty(const ds_slotmap * slotmap)
+{
+    return slotmap->count == 0;
+}
+
+static inline ds_data * _ds_slotmap_at(const ds_slotmap * slotmap, const ds_size index)
+{
+    //assert(0 <= index && index < slotmap->count);
+    return (ds_data *)((ds_byte *)slotmap->items + index * slotmap->item_size);
+}
+
+static inline ds_data * _ds_slotmap_get(const ds_slotmap * slotmap,
+                                        const ds_slotmap_handle handle)
+{
+    uint32_t pos = (uint32_t)handle;
+    if (pos >= (uint32_t)slotmap->slots_count) {
+        return NULL;
+    }
+    const ds_slot * slot = slotmap->slots + pos;
+    if (slot->generation != (uint32_t)(handle >> 32) || (slot->generation & 1) == 0) {
+        // stale
+        return NULL;
+    }
+    return _ds_slotmap_at(slotmap, slot->index);
+}
+
+#if DS_INLINE
+#define ds_slotmap_length(slotmap)         _ds_slotmap_length(slotmap)
+#define ds_slotmap_empty(slotmap)          _ds_slotmap_empty(slotmap)
+#define ds_slotmap_at(slotmap, index)      _ds_slotmap_at(slotmap, index)
+#define ds_slotmap_get(slotmap, handle)    _ds_slotmap_get(slotmap, handle)
+#endif
+
+#endif /* defined(__ds_slotmap__) */
@@ -0,0 +1,141 @@
+//
+//  ds_spsc_queue.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_spsc_queue.h"
+
+static inline void _spsc_queue_assign(const ds_spsc_queue * queue,
+                                      ds_data * dest, const ds_data src)
+{
+    if (queue->fn.assign) {
+	    queue->fn.assign(dest, src, queue->item_size);
+    } else if (queue->bk.assign) {
+	    queue->bk.assign(dest, src, queue->item_size);
+    } else {
+	    memcpy(dest, &src, queue->item_size);
+    }
+}
+
+static inline ds_data * _spsc_queue_at(const ds_spsc_queue * queue, const size_t pos)
+{
+    ds_byte * ptr = (ds_byte *)queue->items;
+    return (ds_data *)(ptr + (pos & queue->mask) * queue->item_size);
+}
+
+#pragma mark -
+
+ds_spsc_queue * ds_spsc_queue_create(const ds_size item_size,
+                                     const ds_size capacity)
+{
+    // aligned to cache line for the padded head/tail
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_spsc_queue)) != 0) {
+        return NULL;
+    }
+    ds_spsc_queue * queue = (ds_spsc_queue *)ptr;
+    memset(queue, 0, sizeof(ds_spsc_queue));
+    size_t size = 2;
+    while (size < (size_t)capacity) {
+        size <<= 1;
+    }
+    queue->capacity = size;
+    queue->mask = size - 1;
+    queue->item_size = item_size > 0 ? item_size : (ds_size)sizeof(ds_data);
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, size * queue->item_size) != 0) {
+        free(queue);
+        return NULL;
+    }
+    queue->items = (ds_data *)ptr;
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    return queue;
+}
+
+void ds_spsc_queue_destroy(ds_spsc_queue * queue)
+{
+    free(queue->items);
+    queue->items = NULL;
+    free(queue);
+}
+
+ds_size ds_spsc_queue_length(ds_spsc_queue * queue)
+{
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    return (ds_size)(tail - head);
+}
+
+ds_bool ds_spsc_queue_empty(ds_spsc_queue * queue)
+{
+    return ds_spsc_queue_length(queue) == 0;
+}
+
+#pragma mark Producer
+
+ds_bool ds_spsc_queue_write(ds_spsc_queue * queue, const ds_data item)
+{
+    size_t tail = queue->tail_local;
+    if (tail - queue->head_cache == queue->capacity) {
+        // full as last seen, check whether the consumer moved
+        queue->head_cache = atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->head_cache == queue->capacity) {
+            return DSFalse;
+        }
+    }
+    _spsc_queue_assign(queue, _spsc_queue_at(queue, tail), item);
+    queue->tail_local = tail + 1;
+    return DSTrue;
+}
+
+void ds_spsc_queue_publish(ds_spsc_queue * queue)
+{
+    // items written before are visible to the consumer who sees this tail
+    atomic_store_explicit(&queue->tail, queue->tail_local, memory_order_release);
+}
+
+ds_bool ds_spsc_queue_push(ds_spsc_queue * queue, const ds_data item)
+{
+    if (!ds_spsc_queue_write(queue, item)) {
+        return DSFalse;
+    }
+    atomic_store_explicit(&queue->tail, queue->tail_local, memory_order_release);
+    return DSTrue;
+}
+
+#pragma mark Consumer
+
+ds_spsc_queue_node * ds_spsc_queue_shift(ds_spsc_queue * queue)
+{
+    size_t head = queue->head_local;
+    // the previous item is done, give back its space
+    if (atomic_load_explicit(&queue->head, memory_order_relaxed) != head) {
+        atomic_store_explicit(&queue->head, head, memory_order_release);
+    }
+    if (head == queue->tail_cache) {
+        // empty as last seen, check whether the producer published more
+        queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if (head == queue->tail_cache) {
+            return NULL;
+        }
+    }
+    queue->head_local = head + 1;
+    return _spsc_queue_at(queue, head);
+}
+
+ds_size ds_spsc_queue_available(ds_spsc_queue * queue)
+{
+    queue->tail_cache = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    return (ds_size)(queue->tail_cache - queue->head_local);
+}
+
+void ds_spsc_queue_release(ds_spsc_queue * queue)
+{
+    atomic_store_explicit(&queue->head, queue->head_local, memory_order_release);
+}
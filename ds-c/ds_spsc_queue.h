@@ -0,0 +1,139 @@
+//
+//  ds_spsc_queue.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_spsc_queue__
+#define __ds_spsc_queue__
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "ds_base.h"
+
+//
+//  Single-producer/single-consumer ring buffer
+//
+//      The lock-free variant of 'ds_circular_queue', for handing off items
+//  from ONE producer thread to ONE consumer thread. The items are stored
+//  in place with the same 'item_size' and 'assign' hooks, but the capacity
+//  is fixed (rounded up to power of two) and the queue never expands.
+//
+//      The head/tail counters run freely and are masked into the buffer,
+//  so all slots can be used; each side keeps a cached copy of the opposite
+//  counter and only reloads it (acquire) when the cache says full/empty.
+//
+//  Usage:
+//      producer: 'ds_spsc_queue_push()' publishes each item at once; or
+//                'ds_spsc_queue_write()' many items, then publish them all
+//                by one 'ds_spsc_queue_publish()';
+//      consumer: 'ds_spsc_queue_shift()' returns the item in place, which is
+//                valid until next shift, or until 'ds_spsc_queue_release()';
+//                drain it by shifting until NULL, or count the items left by
+//                'ds_spsc_queue_available()', e.g.:
+//
+//                    while ((item = ds_spsc_queue_shift(queue))) { ... }
+//                    ds_spsc_queue_release(queue);
+//
+//      'ds_spsc_queue_length()' counts the items not given back yet, so the
+//  last item shifted is still counted until next shift or release.
+//
+
+typedef struct _ds_spsc_queue {
+
+    size_t capacity; // power of two
+    size_t mask;     // capacity - 1
+
+    ds_size item_size;
+    ds_data * items;
+
+    // functions
+    struct {
+	    ds_assign_func   assign;
+    } fn;
+    // blocks
+    struct {
+	    ds_assign_block  assign;
+    } bk;
+
+    // written by producer, read by consumer
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(size_t) tail;
+    // producer only
+    _Alignas(DS_CACHE_LINE_SIZE) size_t tail_local; // next slot to write
+    size_t head_cache;                              // last seen head
+
+    // written by consumer, read by producer
+    _Alignas(DS_CACHE_LINE_SIZE) _Atomic(size_t) head;
+    // consumer only
+    _Alignas(DS_CACHE_LINE_SIZE) size_t head_local; // next slot to read
+    size_t tail_cache;                              // last seen tail
+} ds_spsc_queue;
+
+typedef ds_data         ds_spsc_queue_node;
+
+/**
+ *  create a queue struct with item size and capacity (rounded up to power of two)
+ */
+ds_spsc_queue * ds_spsc_queue_create(const ds_size item_size,
+                                     const ds_size capacity);
+
+/**
+ *  destroy the queue struct and its items
+ */
+void ds_spsc_queue_destroy(ds_spsc_queue * queue);
+
+/**
+ *  get items count, including the shifted items not released
+ *  (just a snapshot when called by other threads)
+ */
+ds_size ds_spsc_queue_length(ds_spsc_queue * queue);
+
+/**
+ *  check whether the queue is empty, the shifted items not released are counted
+ *  (just a snapshot when called by other threads)
+ */
+ds_bool ds_spsc_queue_empty(ds_spsc_queue * queue);
+
+#pragma mark Producer
+
+/**
+ *  copy the item to tail of the queue, but not visible to consumer before published
+ *
+ * @return DSFalse when the queue is full
+ */
+ds_bool ds_spsc_queue_write(ds_spsc_queue * queue, const ds_data item);
+
+/**
+ *  make all written items visible to consumer
+ */
+void ds_spsc_queue_publish(ds_spsc_queue * queue);
+
+/**
+ *  write the item and publish it
+ *
+ * @return DSFalse when the queue is full
+ */
+ds_bool ds_spsc_queue_push(ds_spsc_queue * queue, const ds_data item);
+
+#pragma mark Consumer
+
+/**
+ *  remove head item from the queue and return it (in place), or NULL when empty;
+ *  the item is valid until next shift (or release), then its space will be reused
+ */
+ds_spsc_queue_node * ds_spsc_queue_shift(ds_spsc_queue * queue);
+
+/**
+ *  get count of items can be shifted now
+ */
+ds_size ds_spsc_queue_available(ds_spsc_queue * queue);
+
+/**
+ *  give back the spaces of the shifted items to producer
+ */
+void ds_spsc_queue_release(ds_spsc_queue * queue);
+
+#endif /* defined(__ds_spsc_queue__) */
@@ -60,6 +60,11 @@ void ds_chain_stack_node_destroy(ds_chain_stack_node * node)
     ds_chain_node_destroy(node);
 }
 
+void ds_chain_stack_node_recycle(ds_chain_stack * stack, ds_chain_stack_node * node)
+{
+    ds_chain_node_recycle(stack, node);
+}
+
 ds_chain_stack * ds_chain_stack_copy(const ds_chain_stack * stack,
                                      const ds_size data_size)
 {
@@ -124,6 +129,60 @@ ds_array_stack * ds_array_stack_copy(const ds_array_stack * stack)
     return ds_array_copy(stack);
 }
 
+#pragma mark - Stack base on ds_unrolled_chain
+
+ds_unrolled_stack * ds_unrolled_stack_create(const ds_size item_size,
+                                             const ds_size node_capacity)
+{
+    return ds_unrolled_chain_create(item_size, node_capacity);
+}
+
+void ds_unrolled_stack_destroy(ds_unrolled_stack * stack)
+{
+    ds_unrolled_chain_destroy(stack);
+}
+
+ds_size ds_unrolled_stack_length(const ds_unrolled_stack * stack)
+{
+    return ds_unrolled_chain_length(stack);
+}
+
+ds_bool ds_unrolled_stack_empty(const ds_unrolled_stack * stack)
+{
+    return ds_unrolled_chain_empty(stack);
+}
+
+void ds_unrolled_stack_clear(ds_unrolled_stack * stack)
+{
+    ds_unrolled_chain_clear(stack);
+}
+
+void ds_unrolled_stack_push(ds_unrolled_stack * stack, const ds_data item)
+{
+    ds_unrolled_chain_append(stack, item);
+}
+
+ds_data * ds_unrolled_stack_pop(ds_unrolled_stack * stack)
+{
+    return ds_unrolled_chain_pop(stack);
+}
+
+ds_data * ds_unrolled_stack_top(const ds_unrolled_stack * stack)
+{
+    ds_unrolled_node * node = stack->tail;
+    if (node == NULL) {
+	    // stack empty
+	    return NULL;
+    }
+    // return the last item
+    return ds_unrolled_node_at(stack, node, node->count - 1);
+}
+
+ds_unrolled_stack * ds_unrolled_stack_copy(const ds_unrolled_stack * stack)
+{
+    return ds_unrolled_chain_copy(stack);
+}
+
 #pragma mark - Default stack
 
 ds_stack * ds_stack_create(const ds_size item_size,
@@ -11,6 +11,7 @@
 
 #include "ds_array.h"
 #include "ds_chain.h"
+#include "ds_unrolled_chain.h"
 
 #pragma mark Stack base on ds_chain_table
 
@@ -64,6 +65,11 @@ ds_chain_stack_node * ds_chain_stack_top(const ds_chain_stack * stack);
  */
 void ds_chain_stack_node_destroy(ds_chain_stack_node * node);
 
+/**
+ *  give back the node (removed from the stack already) to reuse it by next push
+ */
+void ds_chain_stack_node_recycle(ds_chain_stack * stack, ds_chain_stack_node * node);
+
 /**
  *  copy the stack
  */
@@ -121,6 +127,58 @@ ds_array_stack_node * ds_array_stack_top(const ds_array_stack * stack);
  */
 ds_array_stack * ds_array_stack_copy(const ds_array_stack * stack);
 
+#pragma mark - Stack base on ds_unrolled_chain
+
+typedef ds_data            ds_unrolled_stack_node;
+typedef ds_unrolled_chain  ds_unrolled_stack;
+
+/**
+ *  create a stack struct with item size and max count of items in each node
+ */
+ds_unrolled_stack * ds_unrolled_stack_create(const ds_size item_size,
+                                             const ds_size node_capacity);
+
+/**
+ *  destroy the stack struct and its items
+ */
+void ds_unrolled_stack_destroy(ds_unrolled_stack * stack);
+
+/**
+ *  get items count
+ */
+ds_size ds_unrolled_stack_length(const ds_unrolled_stack * stack);
+
+/**
+ *  check whether the stack is empty
+ */
+ds_bool ds_unrolled_stack_empty(const ds_unrolled_stack * stack);
+
+/**
+ *  clear the stack
+ */
+void ds_unrolled_stack_clear(ds_unrolled_stack * stack);
+
+/**
+ *  push item to top of stack (chain tail)
+ */
+void ds_unrolled_stack_push(ds_unrolled_stack * stack, const ds_data item);
+
+/**
+ *  remove top item from the stack and return it (but NOT erase),
+ *  the item is valid until next push
+ */
+ds_unrolled_stack_node * ds_unrolled_stack_pop(ds_unrolled_stack * stack);
+
+/**
+ *  get top item (not removed)
+ */
+ds_unrolled_stack_node * ds_unrolled_stack_top(const ds_unrolled_stack * stack);
+
+/**
+ *  copy the stack
+ */
+ds_unrolled_stack * ds_unrolled_stack_copy(const ds_unrolled_stack * stack);
+
 #pragma mark - Default stack
 
 typedef ds_array_stack_node ds_stack_node;
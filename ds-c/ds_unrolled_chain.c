@@ -0,0 +1,381 @@
+//
+//  ds_unrolled_chain.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_unrolled_chain.h"
+
+#define DS_ITEM(node, pos) ((ds_byte *)ds_unrolled_node_at(chain, node, pos))
+
+static inline ds_unrolled_node * _unrolled_create_node(ds_unrolled_chain * chain)
+{
+    ds_unrolled_node * node = chain->spare;
+    if (node) {
+        chain->spare = NULL;
+    } else {
+        // node struct + items, rounded up to the cache line size
+        size_t len = sizeof(ds_unrolled_node) + chain->node_capacity * chain->item_size;
+        len = (len + DS_CACHE_LINE_SIZE - 1) / DS_CACHE_LINE_SIZE * DS_CACHE_LINE_SIZE;
+        void * ptr = NULL;
+        if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, len) != 0) {
+            // out of memory, the callers cannot go on without the node
+            abort();
+        }
+        node = (ds_unrolled_node *)ptr;
+    }
+    node->next = NULL;
+    node->prev = NULL;
+    node->offset = 0;
+    node->count = 0;
+    return node;
+}
+
+// keep the emptied node as spare, so the item just removed is still readable
+// until the chain is modified again (the previous spare is freed here)
+static inline void _unrolled_release_node(ds_unrolled_chain * chain,
+                                          ds_unrolled_node * node)
+{
+    free(chain->spare);
+    chain->spare = node;
+}
+
+// link the node after prev (or as head node when prev == NULL)
+static inline void _unrolled_link(ds_unrolled_chain * chain,
+                                  ds_unrolled_node * node,
+                                  ds_unrolled_node * prev)
+{
+    node->prev = prev;
+    node->next = prev ? prev->next : chain->head;
+    if (node->next) {
+        node->next->prev = node;
+    } else {
+        chain->tail = node;
+    }
+    if (prev) {
+        prev->next = node;
+    } else {
+        chain->head = node;
+    }
+}
+
+static inline void _unrolled_unlink(ds_unrolled_chain * chain,
+                                    ds_unrolled_node * node)
+{
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        chain->head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        chain->tail = node->prev;
+    }
+}
+
+// move the items to the front of the node
+static inline void _unrolled_compact(ds_unrolled_chain * chain,
+                                     ds_unrolled_node * node)
+{
+    if (node->offset > 0) {
+        ds_byte * dest = (ds_byte *)(node + 1);
+        memmove(dest, DS_ITEM(node, 0), node->count * chain->item_size);
+        node->offset = 0;
+    }
+}
+
+static inline void _unrolled_assign(const ds_unrolled_chain * chain,
+                                    ds_data * dest, const ds_data src)
+{
+    if (chain->fn.assign) {
+        chain->fn.assign(dest, src, chain->item_size);
+    } else if (chain->bk.assign) {
+        chain->bk.assign(dest, src, chain->item_size);
+    } else {
+        memcpy(dest, &src, chain->item_size);
+    }
+}
+
+// seek the node contains the item at index, and change index to the position in it
+static inline ds_unrolled_node * _unrolled_seek(const ds_unrolled_chain * chain,
+                                                ds_size * index)
+{
+    ds_unrolled_node * node;
+    ds_size pos = *index;
+    if (pos < chain->count / 2) {
+        // seeking from head
+        for (node = chain->head; pos >= node->count; node = node->next) {
+            pos -= node->count;
+        }
+    } else {
+        // seeking from tail
+        pos = chain->count - pos; // count of items from the index to the end
+        for (node = chain->tail; pos > node->count; node = node->prev) {
+            pos -= node->count;
+        }
+        pos = node->count - pos;
+    }
+    *index = pos;
+    return node;
+}
+
+// split a full node, move the upper half items to a new node after it
+static inline ds_unrolled_node * _unrolled_split(ds_unrolled_chain * chain,
+                                                 ds_unrolled_node * node)
+{
+    ds_unrolled_node * guest = _unrolled_create_node(chain);
+    ds_size half = node->count / 2;
+    ds_size rest = node->count - half;
+    memcpy(DS_ITEM(guest, 0), DS_ITEM(node, half), rest * chain->item_size);
+    guest->count = rest;
+    node->count = half;
+    _unrolled_link(chain, guest, node);
+    return guest;
+}
+
+// merge the next node into this node if it is small enough
+static inline void _unrolled_merge(ds_unrolled_chain * chain,
+                                   ds_unrolled_node * node)
+{
+    ds_unrolled_node * next = node->next;
+    if (next == NULL || node->count + next->count > chain->node_capacity) {
+        return;
+    }
+    if (node->offset + node->count + next->count > chain->node_capacity) {
+        _unrolled_compact(chain, node);
+    }
+    memcpy(DS_ITEM(node, node->count), DS_ITEM(next, 0), next->count * chain->item_size);
+    node->count += next->count;
+    _unrolled_unlink(chain, next);
+    _unrolled_release_node(chain, next);
+}
+
+#pragma mark -
+
+ds_unrolled_chain * ds_unrolled_chain_create(const ds_size item_size,
+                                             const ds_size node_capacity)
+{
+    ds_unrolled_chain * chain = (ds_unrolled_chain *)malloc(sizeof(ds_unrolled_chain));
+    memset(chain, 0, sizeof(ds_unrolled_chain));
+    chain->item_size = item_size > 0 ? item_size : (ds_size)sizeof(ds_data);
+    if (node_capacity > 0) {
+        chain->node_capacity = node_capacity;
+    } else {
+        chain->node_capacity = (ds_size)((DS_UNROLLED_NODE_SIZE - sizeof(ds_unrolled_node))
+                                         / chain->item_size);
+    }
+    if (chain->node_capacity < 4) {
+        // at least 4 items in a node, or splitting makes no sense
+        chain->node_capacity = 4;
+    }
+    return chain;
+}
+
+void ds_unrolled_chain_destroy(ds_unrolled_chain * chain)
+{
+    // 1. free all nodes
+    ds_unrolled_chain_clear(chain);
+    free(chain->spare);
+    chain->spare = NULL;
+
+    // 2. free the chain struct
+    free(chain);
+}
+
+ds_size (ds_unrolled_chain_length)(const ds_unrolled_chain * chain)
+{
+    return _ds_unrolled_chain_length(chain);
+}
+
+ds_bool (ds_unrolled_chain_empty)(const ds_unrolled_chain * chain)
+{
+    return _ds_unrolled_chain_empty(chain);
+}
+
+void ds_unrolled_chain_clear(ds_unrolled_chain * chain)
+{
+    for (ds_unrolled_node * next; chain->head; chain->head = next) {
+        next = chain->head->next;
+        _unrolled_release_node(chain, chain->head);
+    }
+    chain->tail = NULL;
+    chain->count = 0;
+}
+
+ds_data * ds_unrolled_chain_at(const ds_unrolled_chain * chain, ds_size index)
+{
+    //assert(0 <= index && index < chain->count);
+    ds_unrolled_node * node = _unrolled_seek(chain, &index);
+    return ds_unrolled_node_at(chain, node, index);
+}
+
+ds_size ds_unrolled_chain_find(const ds_unrolled_chain * chain, const ds_data data)
+{
+    ds_data * item;
+    ds_size index;
+    if (chain->fn.compare) {
+        DS_UNROLLED_CHAIN_FOR_EACH_ITEM(chain, item, index) {
+            if (chain->fn.compare(*item, data) == 0) {
+                return index;
+            }
+        }
+    } else if (chain->bk.compare) {
+        DS_UNROLLED_CHAIN_FOR_EACH_ITEM(chain, item, index) {
+            if (chain->bk.compare(*item, data) == 0) {
+                return index;
+            }
+        }
+    } else {
+        //S9Log(@"cannot search the chain without comparing function");
+    }
+    return DSNotFound;
+}
+
+void ds_unrolled_chain_append(ds_unrolled_chain * chain, const ds_data data)
+{
+    ds_unrolled_node * node = chain->tail;
+    if (node == NULL) {
+        node = _unrolled_create_node(chain);
+        _unrolled_link(chain, node, NULL);
+    } else if (node->offset + node->count >= chain->node_capacity) {
+        if (node->count < chain->node_capacity) {
+            // spaces left in front of the node
+            _unrolled_compact(chain, node);
+        } else {
+            // tail node full, add a new one
+            ds_unrolled_node * guest = _unrolled_create_node(chain);
+            _unrolled_link(chain, guest, node);
+            node = guest;
+        }
+    }
+    _unrolled_assign(chain, ds_unrolled_node_at(chain, node, node->count), data);
+    node->count += 1;
+    chain->count += 1;
+}
+
+void ds_unrolled_chain_insert(ds_unrolled_chain * chain, ds_size index,
+                              const ds_data data)
+{
+    if (index >= chain->count) {
+        ds_unrolled_chain_append(chain, data);
+        return;
+    }
+    // 1. seek the node
+    ds_unrolled_node * node = _unrolled_seek(chain, &index);
+    if (index == 0 && node->offset > 0) {
+        // space in front of the node
+        node->offset -= 1;
+        node->count += 1;
+        chain->count += 1;
+        _unrolled_assign(chain, ds_unrolled_node_at(chain, node, 0), data);
+        return;
+    }
+    // 2. check capacity
+    if (node->count >= chain->node_capacity) {
+        ds_unrolled_node * guest = _unrolled_split(chain, node);
+        if (index > node->count) {
+            index -= node->count;
+            node = guest;
+        }
+    }
+    if (node->offset + node->count >= chain->node_capacity) {
+        _unrolled_compact(chain, node);
+    }
+    // 3. move the rest items backwards from the position
+    ds_byte * src = DS_ITEM(node, index);
+    memmove(src + chain->item_size, src, (node->count - index) * chain->item_size);
+    node->count += 1;
+    chain->count += 1;
+    // 4. set data at the position
+    _unrolled_assign(chain, (ds_data *)src, data);
+}
+
+void ds_unrolled_chain_remove(ds_unrolled_chain * chain, ds_size index)
+{
+    //assert(0 <= index && index < chain->count);
+    ds_unrolled_node * node = _unrolled_seek(chain, &index);
+    if (index == 0) {
+        // remove the first item in the node
+        node->offset += 1;
+    } else if (index + 1 < node->count) {
+        // move subsequent items forwards
+        ds_byte * dest = DS_ITEM(node, index);
+        memmove(dest, dest + chain->item_size, (node->count - index - 1) * chain->item_size);
+    }
+    node->count -= 1;
+    chain->count -= 1;
+
+    if (node->count == 0) {
+        _unrolled_unlink(chain, node);
+        _unrolled_release_node(chain, node);
+    } else if (node->count < chain->node_capacity / 2) {
+        // less than half full, merge with the neighbour
+        if (node->next) {
+            _unrolled_merge(chain, node);
+        } else if (node->prev) {
+            _unrolled_merge(chain, node->prev);
+        }
+    }
+}
+
+ds_data * ds_unrolled_chain_shift(ds_unrolled_chain * chain)
+{
+    ds_unrolled_node * node = chain->head;
+    if (node == NULL) {
+        // empty chain
+        return NULL;
+    }
+    ds_data * item = ds_unrolled_node_at(chain, node, 0);
+    node->offset += 1;
+    node->count -= 1;
+    chain->count -= 1;
+    if (node->count == 0) {
+        _unrolled_unlink(chain, node);
+        _unrolled_release_node(chain, node);
+    }
+    return item;
+}
+
+ds_data * ds_unrolled_chain_pop(ds_unrolled_chain * chain)
+{
+    ds_unrolled_node * node = chain->tail;
+    if (node == NULL) {
+        // empty chain
+        return NULL;
+    }
+    node->count -= 1;
+    chain->count -= 1;
+    ds_data * item = ds_unrolled_node_at(chain, node, node->count);
+    if (node->count == 0) {
+        _unrolled_unlink(chain, node);
+        _unrolled_release_node(chain, node);
+    }
+    return item;
+}
+
+ds_unrolled_chain * ds_unrolled_chain_copy(const ds_unrolled_chain * chain)
+{
+    ds_unrolled_chain * new_chain = ds_unrolled_chain_create(chain->item_size,
+                                                             chain->node_capacity);
+
+    new_chain->fn.assign  = chain->fn.assign;
+    new_chain->fn.erase   = chain->fn.erase;
+    new_chain->fn.compare = chain->fn.compare;
+    new_chain->bk.assign  = chain->bk.assign;
+    new_chain->bk.erase   = chain->bk.erase;
+    new_chain->bk.compare = chain->bk.compare;
+
+    ds_data * item;
+    ds_size index;
+    DS_UNROLLED_CHAIN_FOR_EACH_ITEM(chain, item, index) {
+        ds_unrolled_chain_append(new_chain, *item);
+    }
+
+    return new_chain;
+}
@@ -0,0 +1,203 @@
+//
+//  ds_unrolled_chain.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_unrolled_chain__
+#define __ds_unrolled_chain__
+
+#include "ds_base.h"
+
+//
+//  Unrolled linked list
+//
+//      Each node holds a block of items (the node memory is a multiple of the
+//  cache line size), so the items are enumerated almost as fast as an array,
+//  while inserting/removing in the middle only moves the items in one node.
+//  A full node will be split into two halves when inserting, and a node will
+//  be merged with its neighbour when it is less than half full after removing.
+//
+
+// default memory size of each node (struct + items)
+#define DS_UNROLLED_NODE_SIZE  (DS_CACHE_LINE_SIZE * 4)
+
+typedef struct _ds_unrolled_node {
+
+    struct _ds_unrolled_node * next;
+    struct _ds_unrolled_node * prev;
+
+    ds_size offset; // position of the first item in this node
+    ds_size count;  // count of items in this node
+} ds_unrolled_node;
+
+typedef struct _ds_unrolled_chain {
+
+    ds_unrolled_node * head;
+    ds_unrolled_node * tail;
+    ds_size count; // count of all items
+
+    ds_size item_size;
+    ds_size node_capacity; // max count of items in each node
+
+    ds_unrolled_node * spare; // the last emptied node, reused by next allocation
+
+    // functions
+    struct {
+	    ds_assign_func   assign;
+	    ds_erase_func    erase;
+	    ds_compare_func  compare;
+    } fn;
+    // blocks
+    struct {
+	    ds_assign_block  assign;
+	    ds_erase_block   erase;
+	    ds_compare_block compare;
+    } bk;
+} ds_unrolled_chain;
+
+// items of the node are stored right after the node struct
+#define ds_unrolled_node_at(chain, node, pos)                                  \
+    ((ds_data *)((ds_byte *)((ds_unrolled_node *)(node) + 1) +                 \
+                 ((node)->offset + (pos)) * (chain)->item_size))               \
+                                                 /* EOF 'ds_unrolled_node_at' */
+
+//
+//  Iterator
+//
+typedef struct _ds_unrolled_iterator {
+    ds_unrolled_node * node;
+    ds_byte * ptr; // current item, NULL when finished
+    ds_byte * end; // end of the items in current node
+} ds_unrolled_iterator;
+
+static inline ds_unrolled_iterator _ds_unrolled_chain_begin(const ds_unrolled_chain * chain)
+{
+    ds_unrolled_iterator it = {chain->head, NULL, NULL};
+    if (it.node) {
+        it.ptr = (ds_byte *)ds_unrolled_node_at(chain, it.node, 0);
+        it.end = it.ptr + it.node->count * chain->item_size;
+    }
+    return it;
+}
+
+static inline void _ds_unrolled_chain_next(const ds_unrolled_chain * chain,
+                                           ds_unrolled_iterator * it)
+{
+    it->ptr += chain->item_size;
+    if (it->ptr == it->end) {
+        // no empty node in the chain, so the next one must have items
+        it->node = it->node->next;
+        if (it->node) {
+            it->ptr = (ds_byte *)ds_unrolled_node_at(chain, it->node, 0);
+            it->end = it->ptr + it->node->count * chain->item_size;
+        } else {
+            it->ptr = NULL;
+        }
+    }
+}
+
+#define DS_UNROLLED_CHAIN_FOR_EACH_ITEM(chain, item, index)                    \
+    for (ds_unrolled_iterator __it = ((index) = 0,                             \
+                                      _ds_unrolled_chain_begin(chain));        \
+         (item) = (__typeof__(item))__it.ptr, __it.ptr;                        \
+         _ds_unrolled_chain_next(chain, &__it), ++(index))                     \
+                                     /* EOF 'DS_UNROLLED_CHAIN_FOR_EACH_ITEM' */
+
+#define DS_UNROLLED_CHAIN_FOR_EACH_NODE(chain, node)                           \
+    for ((node) = (chain)->head; (node); (node) = (node)->next)                \
+                                     /* EOF 'DS_UNROLLED_CHAIN_FOR_EACH_NODE' */
+
+/**
+ *  create an unrolled chain with item size and max count of items in each node
+ *  (node_capacity = 0 means filling a node with 'DS_UNROLLED_NODE_SIZE' bytes)
+ */
+ds_unrolled_chain * ds_unrolled_chain_create(const ds_size item_size,
+                                             const ds_size node_capacity);
+
+/**
+ *  destroy the chain and all its nodes
+ */
+void ds_unrolled_chain_destroy(ds_unrolled_chain * chain);
+
+/**
+ *  get chain->count
+ */
+ds_size ds_unrolled_chain_length(const ds_unrolled_chain * chain);
+
+/**
+ *  check chain->count == 0
+ */
+ds_bool ds_unrolled_chain_empty(const ds_unrolled_chain * chain);
+
+/**
+ *  remove all items
+ */
+void ds_unrolled_chain_clear(ds_unrolled_chain * chain);
+
+/**
+ *  get item at the position of the chain
+ */
+ds_data * ds_unrolled_chain_at(const ds_unrolled_chain * chain, const ds_size index);
+
+/**
+ *  get first position has the same data value
+ */
+ds_size ds_unrolled_chain_find(const ds_unrolled_chain * chain, const ds_data data);
+
+/**
+ *  append data to the tail of the chain
+ */
+void ds_unrolled_chain_append(ds_unrolled_chain * chain, const ds_data data);
+
+/**
+ *  insert data at the position (append to tail when index >= length),
+ *  shifts the item currently at that position and any subsequent items to the right.
+ */
+void ds_unrolled_chain_insert(ds_unrolled_chain * chain, const ds_size index,
+                              const ds_data data);
+
+/**
+ *  remove the item at the position of the chain
+ */
+void ds_unrolled_chain_remove(ds_unrolled_chain * chain, const ds_size index);
+
+/**
+ *  remove head item and return it (but NOT erase),
+ *  the item is valid until the next modification of the chain
+ *  (another node emptied may free the node holding it)
+ */
+ds_data * ds_unrolled_chain_shift(ds_unrolled_chain * chain);
+
+/**
+ *  remove tail item and return it (but NOT erase),
+ *  the item is valid until the next modification of the chain
+ *  (another node emptied may free the node holding it)
+ */
+ds_data * ds_unrolled_chain_pop(ds_unrolled_chain * chain);
+
+/**
+ *  copy the chain (all nodes are packed in the new chain)
+ */
+ds_unrolled_chain * ds_unrolled_chain_copy(const ds_unrolled_chain * chain);
+
+#pragma mark - Inline accessors
+
+static inline ds_size _ds_unrolled_chain_length(const ds_unrolled_chain * chain)
+{
+    return chain->count;
+}
+
+static inline ds_bool _ds_unrolled_chain_empty(const ds_unrolled_chain * chain)
+{
+    return chain->count == 0;
+}
+
+#if DS_INLINE
+#define ds_unrolled_chain_length(chain)  _ds_unrolled_chain_length(chain)
+#define ds_unrolled_chain_empty(chain)   _ds_unrolled_chain_empty(chain)
+#endif
+
+#endif /* defined(__ds_unrolled_chain__) */
@@ -0,0 +1,146 @@
+//
+//  ds_ws_deque.c
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ds_ws_deque.h"
+
+#define _ws_slot(buffer, index)  (&(buffer)->items[(index) & ((buffer)->capacity - 1)])
+
+static inline ds_ws_buffer * _ws_buffer_create(const long capacity)
+{
+    size_t len = sizeof(ds_ws_buffer) + capacity * sizeof(_Atomic(ds_data));
+    ds_ws_buffer * buffer = (ds_ws_buffer *)malloc(len);
+    buffer->capacity = capacity;
+    buffer->retired = NULL;
+    return buffer;
+}
+
+// move items [top, bottom) to a bigger buffer, keep the old one for thieves
+static inline ds_ws_buffer * _ws_buffer_grow(ds_ws_buffer * buffer,
+                                             const long top, const long bottom)
+{
+    ds_ws_buffer * bigger = _ws_buffer_create(buffer->capacity * 2);
+    ds_data item;
+    for (long index = top; index < bottom; ++index) {
+        item = atomic_load_explicit(_ws_slot(buffer, index), memory_order_relaxed);
+        atomic_store_explicit(_ws_slot(bigger, index), item, memory_order_relaxed);
+    }
+    bigger->retired = buffer;
+    return bigger;
+}
+
+#pragma mark -
+
+ds_ws_deque * ds_ws_deque_create(const ds_size capacity)
+{
+    // aligned to cache line for the padded top/bottom
+    void * ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(ds_ws_deque)) != 0) {
+        return NULL;
+    }
+    ds_ws_deque * deque = (ds_ws_deque *)ptr;
+    memset(deque, 0, sizeof(ds_ws_deque));
+    long size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buffer, _ws_buffer_create(capacity > 0 ? size : 64));
+    return deque;
+}
+
+void ds_ws_deque_destroy(ds_ws_deque * deque)
+{
+    ds_ws_buffer * buffer = atomic_load(&deque->buffer);
+    for (ds_ws_buffer * retired; buffer; buffer = retired) {
+        retired = buffer->retired;
+        free(buffer);
+    }
+    free(deque);
+}
+
+ds_size ds_ws_deque_length(ds_ws_deque * deque)
+{
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    return bottom > top ? (ds_size)(bottom - top) : 0;
+}
+
+ds_bool ds_ws_deque_empty(ds_ws_deque * deque)
+{
+    return ds_ws_deque_length(deque) == 0;
+}
+
+#pragma mark Owner
+
+void ds_ws_deque_push(ds_ws_deque * deque, const ds_data item)
+{
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    ds_ws_buffer * buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    if (bottom - top > buffer->capacity - 1) {
+        // full
+        buffer = _ws_buffer_grow(buffer, top, bottom);
+        atomic_store_explicit(&deque->buffer, buffer, memory_order_release);
+    }
+    atomic_store_explicit(_ws_slot(buffer, bottom), item, memory_order_relaxed);
+    // the item must be visible before the new bottom
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+}
+
+ds_bool ds_ws_deque_pop(ds_ws_deque * deque, ds_data * item)
+{
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    ds_ws_buffer * buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    // take the bottom item first, then check the thieves
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (top > bottom) {
+        // empty
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return DSFalse;
+    }
+    *item = atomic_load_explicit(_ws_slot(buffer, bottom), memory_order_relaxed);
+    if (top < bottom) {
+        // more than one item, no thief can reach this one
+        return DSTrue;
+    }
+    // the last item, race with thieves
+    ds_bool ok = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                         memory_order_seq_cst,
+                                                         memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return ok ? DSTrue : DSFalse;
+}
+
+#pragma mark Thief
+
+ds_ws_deque_status ds_ws_deque_steal(ds_ws_deque * deque, ds_data * item)
+{
+    long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) {
+        return DSWorkStealEmpty;
+    }
+    ds_ws_buffer * buffer = atomic_load_explicit(&deque->buffer, memory_order_acquire);
+    ds_data data = atomic_load_explicit(_ws_slot(buffer, top), memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        // taken by the owner or another thief
+        return DSWorkStealAbort;
+    }
+    *item = data;
+    return DSWorkStealSuccess;
+}
@@ -0,0 +1,94 @@
+//
+//  ds_ws_deque.h
+//  DataStructure
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __ds_ws_deque__
+#define __ds_ws_deque__
+
+#include <stdatomic.h>
+
+#include "ds_base.h"
+
+//
+//  Work-stealing deque (Chase & Lev, with C11 atomics by Lê et al.)
+//
+//      The owner thread pushes and pops items at the bottom (LIFO, hot in its
+//  cache), other threads steal items from the top (FIFO, the oldest ones);
+//  only the last item needs a CAS to decide between the owner and a thief.
+//
+//      The items are words (ds_data: a number, or a pointer to the task),
+//  since a thief may read a slot while the owner is writing another round.
+//  The buffer grows when full; the old buffers may still be read by thieves,
+//  so they are retired and freed when destroying the deque (the total size
+//  of them is less than the current buffer).
+//
+
+enum _ds_ws_deque_status {
+    DSWorkStealSuccess = 0,
+    DSWorkStealEmpty   = 1,
+    DSWorkStealAbort   = 2,  // lost the race with another thread, try again later
+};
+typedef int ds_ws_deque_status;
+
+typedef struct _ds_ws_buffer {
+    long capacity; // power of two
+    struct _ds_ws_buffer * retired; // older buffer
+    _Atomic(ds_data) items[];
+} ds_ws_buffer;
+
+typedef struct _ds_ws_deque {
+
+    // stolen by thieves
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_long top;
+
+    // owner only
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_long bottom;
+    _Atomic(ds_ws_buffer *) buffer;
+} ds_ws_deque;
+
+/**
+ *  create a deque with capacity (rounded up to power of two)
+ */
+ds_ws_deque * ds_ws_deque_create(const ds_size capacity);
+
+/**
+ *  destroy the deque and all buffers (no other thread is using it)
+ */
+void ds_ws_deque_destroy(ds_ws_deque * deque);
+
+/**
+ *  get items count (just a snapshot)
+ */
+ds_size ds_ws_deque_length(ds_ws_deque * deque);
+
+/**
+ *  check whether the deque is empty (just a snapshot)
+ */
+ds_bool ds_ws_deque_empty(ds_ws_deque * deque);
+
+#pragma mark Owner
+
+/**
+ *  push the item to bottom (owner thread only)
+ */
+void ds_ws_deque_push(ds_ws_deque * deque, const ds_data item);
+
+/**
+ *  pop the item from bottom (owner thread only)
+ *
+ * @return DSFalse when empty (or the last one was stolen)
+ */
+ds_bool ds_ws_deque_pop(ds_ws_deque * deque, ds_data * item);
+
+#pragma mark Thief
+
+/**
+ *  steal the item from top (any thread)
+ */
+ds_ws_deque_status ds_ws_deque_steal(ds_ws_deque * deque, ds_data * item);
+
+#endif /* defined(__ds_ws_deque__) */
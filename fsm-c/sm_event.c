@@ -0,0 +1,108 @@
+//
+//  sm_event.c
+//  FiniteStateMachine
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sm_event.h"
+
+static inline void sm_event_table_init_slots(sm_event_table *table, unsigned int capacity)
+{
+    unsigned int shift = 32;
+    for (unsigned int size = capacity; size > 1; size >>= 1) {
+        --shift;
+    }
+    table->shift = shift;
+    table->capacity = capacity;
+    table->slots = (sm_event_slot *)malloc(capacity * sizeof(sm_event_slot));
+    for (unsigned int index = 0; index < capacity; ++index) {
+        table->slots[index].head = -1;
+    }
+}
+
+static inline sm_event_slot *sm_event_table_slot(sm_event_table *table, sm_event_id id)
+{
+    unsigned int mask = table->capacity - 1;
+    unsigned int pos = (id * 2654435769u) >> table->shift;
+    sm_event_slot *slot;
+    for (;; pos = (pos + 1) & mask) {
+        slot = table->slots + pos;
+        if (slot->head < 0 || slot->id == id) {
+            return slot;
+        }
+    }
+}
+
+// double the slots when 3/4 used
+static inline void sm_event_table_expand(sm_event_table *table)
+{
+    sm_event_slot *slots = table->slots;
+    unsigned int capacity = table->capacity;
+    sm_event_table_init_slots(table, capacity * 2);
+    for (unsigned int index = 0; index < capacity; ++index) {
+        if (slots[index].head >= 0) {
+            *sm_event_table_slot(table, slots[index].id) = slots[index];
+        }
+    }
+    free(slots);
+}
+
+sm_event_table *sm_create_event_table(unsigned int capacity)
+{
+    sm_event_table *table = (sm_event_table *)malloc(sizeof(sm_event_table));
+    memset(table, 0, sizeof(sm_event_table));
+    unsigned int size = 4;
+    while (size < capacity * 2) {
+        size <<= 1;
+    }
+    sm_event_table_init_slots(table, size);
+    table->entries_capacity = capacity > 0 ? capacity : 4;
+    table->entries = (sm_event_entry *)malloc(table->entries_capacity * sizeof(sm_event_entry));
+    return table;
+}
+
+void sm_destroy_event_table(sm_event_table *table)
+{
+    free(table->slots);
+    free(table->entries);
+    free(table);
+}
+
+void sm_event_table_add(sm_event_table *table, sm_event_id id, const sm_transition *trans)
+{
+    // 1. append entry
+    if (table->entries_count == table->entries_capacity) {
+        table->entries_capacity *= 2;
+        table->entries = (sm_event_entry *)realloc(table->entries,
+                                                   table->entries_capacity * sizeof(sm_event_entry));
+    }
+    int index = (int)table->entries_count++;
+    table->entries[index].trans = trans;
+    table->entries[index].next = -1;
+    
+    // 2. link to the slot of event id
+    sm_event_slot *slot = sm_event_table_slot(table, id);
+    if (slot->head >= 0) {
+        table->entries[slot->tail].next = index;
+        slot->tail = index;
+        return;
+    }
+    if ((table->count + 1) * 4 > table->capacity * 3) {
+        sm_event_table_expand(table);
+        slot = sm_event_table_slot(table, id);
+    }
+    slot->id = id;
+    slot->head = index;
+    slot->tail = index;
+    table->count += 1;
+}
+
+int (sm_event_table_find)(const sm_event_table *table, sm_event_id id)
+{
+    return _sm_event_table_find(table, id);
+}
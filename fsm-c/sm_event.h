@@ -0,0 +1,76 @@
+//
+//  sm_event.h
+//  FiniteStateMachine
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __sm_event__
+#define __sm_event__
+
+#include "sm_protocol.h"
+
+//
+//  Event table
+//
+//      Transitions of a state keyed by event id: an open addressing table
+//  (Fibonacci hashing, linear probing) maps each event id to a run of
+//  entries, which keeps the transitions in the order they were added.
+//
+
+typedef struct _sm_event_entry {
+    const sm_transition *trans;
+    int next;  // next entry with the same event id, -1 for end
+} sm_event_entry;
+
+typedef struct _sm_event_slot {
+    sm_event_id id;
+    int head;  // first entry, -1 for empty slot
+    int tail;  // last entry
+} sm_event_slot;
+
+typedef struct _sm_event_table {
+    unsigned int shift;     // 32 - log2(capacity)
+    unsigned int capacity;  // slots count, power of two
+    unsigned int count;     // event ids
+    sm_event_slot *slots;
+
+    unsigned int entries_capacity;
+    unsigned int entries_count;
+    sm_event_entry *entries;
+} sm_event_table;
+
+sm_event_table *sm_create_event_table(unsigned int capacity);
+void sm_destroy_event_table(sm_event_table *table);
+
+// append the transition for event id
+void sm_event_table_add(sm_event_table *table, sm_event_id id, const sm_transition *trans);
+
+// get first entry index for event id, -1 for not found
+int sm_event_table_find(const sm_event_table *table, sm_event_id id);
+
+//
+//  Inline accessors
+//
+
+static inline int _sm_event_table_find(const sm_event_table *table, sm_event_id id)
+{
+    unsigned int mask = table->capacity - 1;
+    unsigned int pos = (id * 2654435769u) >> table->shift;
+    const sm_event_slot *slot;
+    for (;; pos = (pos + 1) & mask) {
+        slot = table->slots + pos;
+        if (slot->head < 0) {
+            return -1;
+        } else if (slot->id == id) {
+            return slot->head;
+        }
+    }
+}
+
+#if SM_INLINE
+#define sm_event_table_find(table, id)  _sm_event_table_find(table, id)
+#endif
+
+#endif /* defined(__sm_event__) */
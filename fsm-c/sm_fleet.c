@@ -0,0 +1,220 @@
+//
+//  sm_fleet.c
+//  FiniteStateMachine
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sm_machine.h"
+#include "sm_sealed.h"
+#include "sm_fleet.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define sm_prefetch(addr)  __builtin_prefetch(addr)
+#else
+#define sm_prefetch(addr)
+#endif
+
+#define sm_mask_words(count)  (((count) + 63) / 64)
+
+static inline void sm_fleet_expand(sm_fleet *fleet)
+{
+    unsigned int words = sm_mask_words(fleet->capacity);
+    fleet->capacity *= 2;
+    fleet->machines = (sm_machine **)realloc(fleet->machines, fleet->capacity * sizeof(sm_machine *));
+    fleet->current = (int *)realloc(fleet->current, fleet->capacity * sizeof(int));
+    fleet->order = (unsigned int *)realloc(fleet->order, fleet->capacity * sizeof(unsigned int));
+    fleet->running = (uint64_t *)realloc(fleet->running, sm_mask_words(fleet->capacity) * sizeof(uint64_t));
+    memset(fleet->running + words, 0, (sm_mask_words(fleet->capacity) - words) * sizeof(uint64_t));
+}
+
+static inline void sm_fleet_set_running(sm_fleet *fleet, unsigned int index, sm_bool running)
+{
+    uint64_t bit = (uint64_t)1 << (index & 63);
+    if (running) {
+        fleet->running[index >> 6] |= bit;
+    } else {
+        fleet->running[index >> 6] &= ~bit;
+    }
+}
+
+sm_fleet *sm_create_fleet(unsigned int capacity)
+{
+    sm_fleet *fleet = (sm_fleet *)malloc(sizeof(sm_fleet));
+    memset(fleet, 0, sizeof(sm_fleet));
+    fleet->capacity = capacity > 0 ? capacity : 64;
+    fleet->machines = (sm_machine **)malloc(fleet->capacity * sizeof(sm_machine *));
+    fleet->current = (int *)malloc(fleet->capacity * sizeof(int));
+    fleet->order = (unsigned int *)malloc(fleet->capacity * sizeof(unsigned int));
+    fleet->running = (uint64_t *)calloc(sm_mask_words(fleet->capacity), sizeof(uint64_t));
+    fleet->groups_capacity = 16;
+    fleet->groups = (unsigned int *)malloc(fleet->groups_capacity * sizeof(unsigned int));
+    return fleet;
+}
+
+void sm_destroy_fleet(sm_fleet *fleet)
+{
+    for (unsigned int index = 0; index < fleet->count; ++index) {
+        if (fleet->machines[index] != NULL) {
+            fleet->machines[index]->fleet = NULL;
+        }
+    }
+    free(fleet->machines);
+    free(fleet->current);
+    free(fleet->running);
+    free(fleet->order);
+    free(fleet->groups);
+    free(fleet);
+}
+
+void sm_fleet_add(sm_fleet *fleet, sm_machine *machine)
+{
+    if (machine->fleet != NULL) {
+        // in a fleet already
+        return;
+    }
+    if (fleet->count == fleet->capacity) {
+        sm_fleet_expand(fleet);
+    }
+    unsigned int index = fleet->count++;
+    fleet->machines[index] = machine;
+    machine->fleet = fleet;
+    machine->fleet_index = index;
+    sm_fleet_update(fleet, index);
+}
+
+void sm_fleet_remove(sm_fleet *fleet, sm_machine *machine)
+{
+    if (machine->fleet != fleet) {
+        return;
+    }
+    unsigned int index = machine->fleet_index;
+    machine->fleet = NULL;
+    if (fleet->ticking) {
+        // leave a hole, fill it after ticking
+        fleet->machines[index] = NULL;
+        sm_fleet_set_running(fleet, index, SMFalse);
+        ++fleet->holes;
+        return;
+    }
+    unsigned int last = --fleet->count;
+    if (index < last) {
+        // move the last one here
+        sm_machine *moved = fleet->machines[last];
+        fleet->machines[index] = moved;
+        moved->fleet_index = index;
+        sm_fleet_update(fleet, index);
+    }
+    sm_fleet_set_running(fleet, last, SMFalse);
+}
+
+void sm_fleet_update(sm_fleet *fleet, unsigned int index)
+{
+    const sm_machine *machine = fleet->machines[index];
+    fleet->current[index] = machine->current;
+    sm_fleet_set_running(fleet, index, machine->status == sm_running);
+}
+
+// fill the holes with the last machines
+static inline void sm_fleet_compact(sm_fleet *fleet)
+{
+    unsigned int index = 0;
+    sm_machine *moved;
+    while (fleet->holes > 0 && index < fleet->count) {
+        if (fleet->machines[index] != NULL) {
+            ++index;
+            continue;
+        }
+        moved = fleet->machines[--fleet->count];
+        sm_fleet_set_running(fleet, fleet->count, SMFalse);
+        if (moved == NULL) {
+            // the last one is a hole too
+            --fleet->holes;
+        } else if (index < fleet->count) {
+            --fleet->holes;
+            fleet->machines[index] = moved;
+            moved->fleet_index = index;
+            sm_fleet_update(fleet, index);
+        }
+    }
+    fleet->holes = 0;
+}
+
+// sort the running machines by current state index (-1 as group 0)
+static inline unsigned int sm_fleet_group(sm_fleet *fleet)
+{
+    unsigned int *groups = fleet->groups;
+    memset(groups, 0, fleet->groups_capacity * sizeof(unsigned int));
+    unsigned int words = sm_mask_words(fleet->count);
+    unsigned int index, key, total = 0;
+    uint64_t mask;
+    // 1. count
+    for (unsigned int w = 0; w < words; ++w) {
+        for (mask = fleet->running[w]; mask != 0; mask &= mask - 1) {
+            index = (w << 6) + (unsigned int)__builtin_ctzll(mask);
+            key = (unsigned int)(fleet->current[index] + 1);
+            if (key + 1 >= fleet->groups_capacity) {
+                unsigned int size = fleet->groups_capacity;
+                while (key + 1 >= fleet->groups_capacity) {
+                    fleet->groups_capacity *= 2;
+                }
+                groups = (unsigned int *)realloc(groups, fleet->groups_capacity * sizeof(unsigned int));
+                memset(groups + size, 0, (fleet->groups_capacity - size) * sizeof(unsigned int));
+                fleet->groups = groups;
+            }
+            groups[key + 1] += 1;
+            ++total;
+        }
+    }
+    // 2. offsets
+    for (key = 1; key < fleet->groups_capacity; ++key) {
+        groups[key] += groups[key - 1];
+    }
+    // 3. place
+    for (unsigned int w = 0; w < words; ++w) {
+        for (mask = fleet->running[w]; mask != 0; mask &= mask - 1) {
+            index = (w << 6) + (unsigned int)__builtin_ctzll(mask);
+            key = (unsigned int)(fleet->current[index] + 1);
+            fleet->order[groups[key]++] = index;
+        }
+    }
+    return total;
+}
+
+void sm_tick_machines(sm_fleet *fleet, const sm_time now, const sm_time elapsed)
+{
+    unsigned int total = sm_fleet_group(fleet);
+    const sm_machine *ahead;
+    sm_machine *machine;
+    int current;
+    // the buffers may be moved by adding machines in callbacks,
+    // so read them from the fleet every time
+    fleet->ticking = SMTrue;
+    for (unsigned int pos = 0; pos < total; ++pos) {
+        // prefetch the machine far ahead, and the sealed row of the near one
+        if (pos + 2 * SM_FLEET_PREFETCH_DISTANCE < total) {
+            sm_prefetch(fleet->machines[fleet->order[pos + 2 * SM_FLEET_PREFETCH_DISTANCE]]);
+        }
+        if (pos + SM_FLEET_PREFETCH_DISTANCE < total) {
+            ahead = fleet->machines[fleet->order[pos + SM_FLEET_PREFETCH_DISTANCE]];
+            current = fleet->current[fleet->order[pos + SM_FLEET_PREFETCH_DISTANCE]];
+            if (ahead != NULL && ahead->sealed != NULL && current >= 0) {
+                sm_prefetch(ahead->sealed->states + current);
+            }
+        }
+        machine = fleet->machines[fleet->order[pos]];
+        if (machine == NULL) {
+            // removed in this tick
+            continue;
+        }
+        sm_tick_machine(machine, now, elapsed);
+    }
+    fleet->ticking = SMFalse;
+    if (fleet->holes > 0) {
+        sm_fleet_compact(fleet);
+    }
+}
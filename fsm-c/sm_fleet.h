@@ -0,0 +1,72 @@
+//
+//  sm_fleet.h
+//  FiniteStateMachine
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __sm_fleet__
+#define __sm_fleet__
+
+#include <stdint.h>
+
+#include "sm_protocol.h"
+
+//
+//  Fleet of machines
+//
+//      Ticking a large number of machines in one call: the hot fields of each
+//  machine are mirrored contiguously, the current state index in an array,
+//  and the status as a bit mask of the running ones, so the machines not
+//  running are skipped (64 by one word) without touching them.
+//
+//      The running machines are grouped by their current state index (with a
+//  counting sort), then ticked group by group, so machines built alike run
+//  the same evaluate functions together; the machines (and their sealed
+//  rows) to be ticked next are prefetched.
+//
+//      The mirror is updated by the machine whenever its status or current
+//  state changed, a machine can be in one fleet at most.
+//
+//      The callbacks of a machine ticked by the fleet may add machines to the
+//  fleet, or remove/destroy the other machines in it: the removed ones leave
+//  holes, which are skipped by the rest of the tick and filled after it; the
+//  machines added are ticked since next time. But a machine must not destroy
+//  itself in its own callbacks.
+//
+
+#define SM_FLEET_PREFETCH_DISTANCE  8
+
+typedef struct _sm_fleet {
+    unsigned int capacity;
+    unsigned int count;
+    sm_machine **machines;  // NULL for the holes removed while ticking
+
+    sm_bool      ticking;   // removing leaves holes when ticking
+    unsigned int holes;     // machines removed while ticking
+
+    // hot fields of machines
+    int           *current;  // current state index, -1 for null
+    uint64_t      *running;  // bit mask of running machines (status mirror)
+
+    // buffers for grouping
+    unsigned int *order;
+    unsigned int *groups;
+    unsigned int  groups_capacity;
+} sm_fleet;
+
+sm_fleet *sm_create_fleet(unsigned int capacity);
+void sm_destroy_fleet(sm_fleet *fleet);  // machines are not destroyed
+
+// machines
+void sm_fleet_add   (sm_fleet *fleet, sm_machine *machine);
+void sm_fleet_remove(sm_fleet *fleet, sm_machine *machine);
+
+// update the mirror of the machine at index
+void sm_fleet_update(sm_fleet *fleet, unsigned int index);
+
+// tick all running machines
+void sm_tick_machines(sm_fleet *fleet, const sm_time now, const sm_time elapsed);
+
+#endif /* defined(__sm_fleet__) */
@@ -11,8 +11,6 @@
 
 #include "sm_list.h"
 
-#define SM_VALUE(item)    (sm_list_item)(*item)
-
 #if sm_list_type == sm_array_list
 
 #pragma mark - SM list base on ds_array
@@ -27,18 +25,14 @@ void sm_list_destroy(sm_list *list)
     ds_array_destroy(list);
 }
 
-unsigned int sm_list_length(const sm_list *list)
+unsigned int (sm_list_length)(const sm_list *list)
 {
-    return (unsigned int)list->count;
+    return _sm_list_length(list);
 }
 
-sm_list_item sm_list_get(const sm_list *list, int index)
+sm_list_item (sm_list_get)(const sm_list *list, int index)
 {
-    ds_data * data = ds_array_at(list, index);
-    if (data == NULL) {
-        return NULL;
-    }
-    return SM_VALUE(data);
+    return _sm_list_get(list, index);
 }
 
 void sm_list_set(sm_list *list, int index, const sm_list_item item)
@@ -65,18 +59,14 @@ void sm_list_destroy(sm_list *list)
     ds_chain_destroy(list);
 }
 
-unsigned int sm_list_length(const sm_list *list)
+unsigned int (sm_list_length)(const sm_list *list)
 {
-    return (unsigned int)ds_chain_length(list);
+    return _sm_list_length(list);
 }
 
-sm_list_item sm_list_get(const sm_list *list, int index)
+sm_list_item (sm_list_get)(const sm_list *list, int index)
 {
-    ds_chain_node * node = ds_chain_at(list, index);
-    if (node == NULL) {
-        return NULL;
-    }
-    return SM_VALUE(node->data);
+    return _sm_list_get(list, index);
 }
 
 void sm_list_set(sm_list *list, int index, const sm_list_item item)
@@ -87,8 +77,8 @@ void sm_list_set(sm_list *list, int index, const sm_list_item item)
         ds_chain_append(list, 0, sizeof(sm_list_item));
     }
     if (index < len) {
-        // update node->data
-        ds_chain_node *node = ds_chain_at(list, index);
+        // update node data (no need to walk the chain for the tail node)
+        ds_chain_node *node = index + 1 == len ? list->tail : ds_chain_at(list, index);
         ds_chain_assign(list, node, (ds_data)item, sizeof(sm_list_item));
     } else {
         // append to tail
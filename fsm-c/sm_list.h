@@ -26,4 +26,119 @@ void sm_list_set(sm_list *list, int index, const sm_list_item item);
 // append item value to the tail
 void sm_list_add(sm_list *list, const sm_list_item item);
 
+//
+//  Inline accessors
+//
+
+#if   sm_list_type == sm_array_list
+
+static inline unsigned int _sm_list_length(const sm_list *list)
+{
+    return (unsigned int)list->count;
+}
+
+static inline sm_list_item _sm_list_get(const sm_list *list, int index)
+{
+    ds_data *data = _ds_array_at(list, index);
+    return (sm_list_item)(*data);
+}
+
+#elif sm_list_type == sm_chain_list
+
+static inline unsigned int _sm_list_length(const sm_list *list)
+{
+    return (unsigned int)_ds_chain_length(list);
+}
+
+static inline sm_list_item _sm_list_get(const sm_list *list, int index)
+{
+    ds_chain_node *node = ds_chain_at(list, index);
+    if (node == NULL) {
+        return NULL;
+    }
+    return (sm_list_item)(*ds_chain_node_data(node));
+}
+
+#endif
+
+#if SM_INLINE
+#define sm_list_length(list)      _sm_list_length(list)
+#define sm_list_get(list, index)  _sm_list_get(list, index)
+#endif
+
+//
+//  Cursor
+//
+//      Enumerate items with O(1) cost per step for both list types
+//      (calling 'sm_list_get' in a loop walks the chain from head every time)
+//
+//  Usage:
+//
+//      sm_list_cursor cursor;
+//      for (cursor = sm_list_begin(list);
+//           !sm_list_done(list, cursor);
+//           cursor = sm_list_next(list, cursor)) {
+//          item = sm_list_item_at(list, cursor);
+//      }
+//
+
+#if   sm_list_type == sm_array_list
+
+typedef unsigned int    sm_list_cursor;  // index of item
+
+static inline sm_list_cursor sm_list_begin(const sm_list *list)
+{
+    (void)list;
+    return 0;
+}
+
+static inline sm_bool sm_list_done(const sm_list *list, const sm_list_cursor cursor)
+{
+    return cursor >= (unsigned int)list->count;
+}
+
+static inline sm_list_cursor sm_list_next(const sm_list *list, const sm_list_cursor cursor)
+{
+    (void)list;
+    return cursor + 1;
+}
+
+static inline sm_list_item sm_list_item_at(const sm_list *list, const sm_list_cursor cursor)
+{
+    return (sm_list_item)(*_ds_array_at(list, cursor));
+}
+
+#elif sm_list_type == sm_chain_list
+
+typedef ds_chain_node * sm_list_cursor;  // chain node of item
+
+static inline sm_list_cursor sm_list_begin(const sm_list *list)
+{
+    return list->head;
+}
+
+static inline sm_bool sm_list_done(const sm_list *list, const sm_list_cursor cursor)
+{
+    return cursor == NULL;
+}
+
+static inline sm_list_cursor sm_list_next(const sm_list *list, const sm_list_cursor cursor)
+{
+    return cursor->next;
+}
+
+static inline sm_list_item sm_list_item_at(const sm_list *list, const sm_list_cursor cursor)
+{
+    return (sm_list_item)(*ds_chain_node_data(cursor));
+}
+
+#endif
+
+#define SM_LIST_FOR_EACH_ITEM(list, cursor, item)                              \
+    for ((cursor) = sm_list_begin(list);                                       \
+         !sm_list_done(list, cursor) &&                                        \
+             ((item) = (__typeof__(item))sm_list_item_at(list, cursor), 1);    \
+         (cursor) = sm_list_next(list, cursor))                                \
+                                               /* EOF 'SM_LIST_FOR_EACH_ITEM' */
+
 #endif /* defined(__sm_list__) */
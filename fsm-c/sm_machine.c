@@ -9,8 +9,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "ds_deque.h"
+
 #include "sm_list.h"
 #include "sm_state.h"
+#include "sm_sealed.h"
+#include "sm_fleet.h"
 #include "sm_machine.h"
 
 sm_machine *sm_create_machine(unsigned int capacity)
@@ -32,8 +36,17 @@ sm_machine *sm_create_machine(unsigned int capacity)
 
 void sm_destroy_machine(sm_machine *machime)
 {
+    if (machime->fleet != NULL) {
+        sm_fleet_remove(machime->fleet, machime);
+    }
     // 1. destroy the chain table for states
     sm_list_destroy(machime->states);
+    if (machime->events != NULL) {
+        ds_deque_destroy(machime->events);
+    }
+    if (machime->sealed != NULL) {
+        sm_destroy_sealed((sm_sealed *)machime->sealed);
+    }
 //    machime->states = NULL;
     
 //    machime->delegate = NULL;
@@ -56,8 +69,15 @@ static inline sm_state *sm_state_at(const sm_machine *machine, unsigned int inde
 
 const sm_state *sm_add_state(sm_machine *machine, const sm_state *state)
 {
+    if (machine->sealed != NULL) {
+        // read-only after sealed
+        return NULL;
+    }
     unsigned int index = state->index;
-    sm_state *old = sm_list_get(machine->states, index);
+    sm_state *old = NULL;
+    if (index < sm_list_length(machine->states)) {
+        old = sm_list_get(machine->states, index);
+    }
     sm_list_set(machine->states, index, (sm_list_item)state);
     return old == state ? NULL : old;
 }
@@ -77,13 +97,17 @@ sm_state *sm_get_target_state(const sm_machine *machine, const sm_transition *tr
     return sm_state_at(machine, trans->target);
 }
 
-sm_state *sm_get_current_state(const sm_machine *machine)
+sm_state *(sm_get_current_state)(const sm_machine *machine)
 {
-    int current = machine->current;
-    if (current < 0) {  // -1
-        return NULL;
+    return _sm_get_current_state(machine);
+}
+
+// mirror the hot fields into the fleet
+static inline void sm_machine_changed(sm_machine *machine)
+{
+    if (machine->fleet != NULL) {
+        sm_fleet_update(machine->fleet, machine->fleet_index);
     }
-    return sm_state_at(machine, current);
 }
 
 static inline void sm_set_current_state(sm_machine *machine, const sm_state *next)
@@ -93,6 +117,7 @@ static inline void sm_set_current_state(sm_machine *machine, const sm_state *nex
     } else {
         machine->current = next->index;
     }
+    sm_machine_changed(machine);
 }
 
 /**
@@ -154,11 +179,17 @@ void sm_start_machine(sm_machine *machine, const sm_time now)
     sm_state *next = sm_get_default_state(machine);
     sm_change_state(machine, next, now);
     machine->status = sm_running;
+    sm_machine_changed(machine);
 }
 
 void sm_stop_machine(sm_machine *machine, const sm_time now)
 {
     machine->status = sm_stopped;
+    sm_machine_changed(machine);
+    // drop the events not dispatched
+    if (machine->events != NULL) {
+        ds_deque_clear(machine->events);
+    }
     // force current state to null
     sm_change_state(machine, NULL, now);
 }
@@ -178,6 +209,7 @@ void sm_pause_machine(sm_machine *machine, const sm_time now)
     //  Pause current state
     //
     machine->status = sm_paused;
+    sm_machine_changed(machine);
     //
     //  Events after state paused
     //
@@ -201,6 +233,7 @@ void sm_resume_machine(sm_machine *machine, const sm_time now)
     //  Pause current state
     //
     machine->status = sm_running;
+    sm_machine_changed(machine);
     //
     //  Events after state resumed
     //
@@ -209,11 +242,58 @@ void sm_resume_machine(sm_machine *machine, const sm_time now)
     }
 }
 
+// dispatch the events posted before this tick,
+// the rest are kept when the machine paused by a handler
+static inline void sm_dispatch_posted_events(sm_machine *machine, const sm_time now)
+{
+    ds_deque *events = machine->events;
+    ds_size count = ds_deque_length(events);
+    sm_event event;
+    for (; count > 0 && machine->status == sm_running; --count) {
+        if (ds_deque_pop_front_n(events, (ds_data *)&event, 1) == 0) {
+            // cleared by stopping
+            break;
+        }
+        sm_dispatch_event(machine, event.id, event.payload, now);
+    }
+}
+
 void sm_tick_machine(sm_machine *machine, const sm_time now, const sm_time elapsed)
 {
+    if (machine->events != NULL && !ds_deque_empty(machine->events) &&
+        machine->status == sm_running) {
+        // events wait while the machine paused
+        sm_dispatch_posted_events(machine, now);
+    }
     sm_context *ctx = machine;
+    const sm_sealed *sealed = machine->sealed;
+    if (sealed != NULL) {
+        // fast path over the sealed layout
+        int index = machine->current;
+        if (index < 0 || machine->status != sm_running) {
+            return;
+        }
+        const sm_sealed_state *row = sealed->states + index;
+        if (row->evaluate != NULL) {
+            const sm_transition *trans = row->evaluate(row->state, ctx, now);
+            // custom evaluate may return any transition, check its target
+            if (trans != NULL && trans->target < sealed->states_count) {
+                sm_change_state(machine, sealed->states[trans->target].state, now);
+            }
+        } else if (row->first < row[1].first) {
+            const sm_sealed_transition *trans = sm_tick_sealed(sealed, index, ctx, now);
+            if (trans != NULL) {
+                sm_change_state(machine, sealed->states[trans->target].state, now);
+            }
+        }
+        return;
+    }
     sm_state *current = machine->current_state(machine);
     if (current != NULL && machine->status == sm_running) {
+        if (current->evaluate == sm_tick_state && sm_list_length(current->transitions) == 0) {
+            // nothing to poll, waiting for events
+            return;
+        }
         const sm_transition *trans = current->evaluate(current, ctx, now);
         if (trans != NULL) {
             sm_state *next = sm_get_target_state(machine, trans);
@@ -221,3 +301,52 @@ void sm_tick_machine(sm_machine *machine, const sm_time now, const sm_time elaps
         }
     }
 }
+
+sm_bool sm_machine_seal(sm_machine *machine)
+{
+    if (machine->sealed != NULL) {
+        // sealed already
+        return SMFalse;
+    }
+    machine->sealed = sm_create_sealed(machine);
+    if (machine->sealed == NULL) {
+        return SMFalse;
+    }
+    // freeze the transitions
+    sm_list_cursor cursor;
+    sm_state *state;
+    SM_LIST_FOR_EACH_ITEM(machine->states, cursor, state) {
+        state->sealed = SMTrue;
+    }
+    return SMTrue;
+}
+
+void sm_post_event(sm_machine *machine, sm_event_id event, void *payload)
+{
+    if (machine->events == NULL) {
+        machine->events = ds_deque_create(sizeof(sm_event), 4);
+    }
+    sm_event item = {event, payload};
+    ds_deque_push_back_n(machine->events, (ds_data *)&item, 1);
+}
+
+sm_bool sm_dispatch_event(sm_machine *machine, sm_event_id event, void *payload, const sm_time now)
+{
+    sm_state *current = machine->current_state(machine);
+    if (current == NULL || machine->status != sm_running) {
+        // dropped
+        return SMFalse;
+    }
+    // the event can be got via ctx while evaluating and changing state
+    sm_event item = {event, payload};
+    const sm_event *outer = machine->event;
+    machine->event = &item;
+    sm_bool changed = SMFalse;
+    const sm_transition *trans = sm_event_state(current, &item, machine, now);
+    if (trans != NULL) {
+        sm_state *next = sm_get_target_state(machine, trans);
+        changed = sm_change_state(machine, next, now);
+    }
+    machine->event = outer;
+    return changed;
+}
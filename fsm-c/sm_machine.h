@@ -9,13 +9,13 @@
 #ifndef __sm_machine__
 #define __sm_machine__
 
-#include "sm_protocol.h"
+#include "sm_list.h"
 
 
 sm_machine *sm_create_machine(unsigned int capacity);
 void sm_destroy_machine(sm_machine *machine);
 
-// states
+// states (refused after sealing)
 const sm_state *sm_add_state  (sm_machine *machine, const sm_state *state);
 sm_state *sm_get_state        (const sm_machine *machine, unsigned int index);
 sm_state *sm_get_default_state(const sm_machine *machine);
@@ -29,4 +29,30 @@ void sm_pause_machine (sm_machine *machine, const sm_time now);
 void sm_resume_machine(sm_machine *machine, const sm_time now);
 void sm_tick_machine  (sm_machine *machine, const sm_time now, const sm_time elapsed);
 
+// compile states & transitions into one read-only block for fast ticking,
+// the machine cannot be changed after sealed
+sm_bool sm_machine_seal(sm_machine *machine);
+
+// events (posted events are queued without locking, post them from the
+// thread ticking the machine)
+void    sm_post_event    (sm_machine *machine, sm_event_id event, void *payload);
+sm_bool sm_dispatch_event(sm_machine *machine, sm_event_id event, void *payload, const sm_time now);
+
+//
+//  Inline accessors
+//
+
+static inline sm_state *_sm_get_current_state(const sm_machine *machine)
+{
+    int current = machine->current;
+    if (current < 0) {  // -1
+        return NULL;
+    }
+    return _sm_list_get(machine->states, current);
+}
+
+#if SM_INLINE
+#define sm_get_current_state(machine)  _sm_get_current_state(machine)
+#endif
+
 #endif /* defined(__sm_machine__) */
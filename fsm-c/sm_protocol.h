@@ -25,6 +25,13 @@
  *  each of them, while one transtion's function "evaluate" return YES, then
  *  the machine will change to the new state by the transtion's target name.
  *
+ *      Transitions can also be triggered by events: post an event to the
+ *  machine, and the next tick will look up the transitions registered with
+ *  the event id in the current state, instead of evaluating all of them; a
+ *  state without polling transitions costs nothing when no event comes.
+ *  Events posted to a paused machine wait until it resumed, and they are
+ *  dropped when the machine stopped.
+ *
  *      When the machine stopped, it will run out from the current state, and
  *  here we should remove all states.
  *
@@ -45,6 +52,11 @@
 #define SMTrue          DSTrue
 #define SMFalse         DSFalse
 
+// inline accessors (sm_list_length/sm_list_get/sm_get_current_state)
+#ifndef SM_INLINE
+#define SM_INLINE       DS_INLINE
+#endif
+
 typedef ds_bool         sm_bool;
 typedef double          sm_time;  // seconds, from Jan 1, 1970 UTC
 
@@ -60,6 +72,7 @@ typedef double          sm_time;  // seconds, from Jan 1, 1970 UTC
 #if   sm_list_type == sm_array_list
 typedef ds_array        sm_list;
 #elif sm_list_type == sm_chain_list
+#include "ds_chain.h"
 typedef ds_chain_table  sm_list;
 #endif
 
@@ -69,10 +82,25 @@ typedef void *          sm_list_item;
 typedef void            sm_context;
 
 
+//
+//  Event
+//
+typedef unsigned int    sm_event_id;
+
+typedef struct _sm_event {
+    sm_event_id  id;
+    void        *payload;
+} sm_event;
+
+
 struct _sm_delegate;
 struct _sm_state;
 struct _sm_transition;
 struct _sm_machine;
+struct _sm_event_table;
+struct _sm_sealed;
+struct _sm_fleet;
+struct _ds_deque;
 
 
 /**
@@ -286,8 +314,10 @@ typedef struct _sm_state {
     
     // properties
     unsigned int index;  // state index in the machine
+    sm_bool      sealed; // transitions are frozen
     
     sm_list *transitions;    // transitions of state
+    struct _sm_event_table *events;  // transitions triggered by events
     
     // methods
     sm_state_enter    on_enter;
@@ -329,6 +359,14 @@ typedef struct _sm_machine {
     enum sm_status  status;    // machine status
     sm_delegate    *delegate;  // machine delegate
     
+    struct _ds_deque *events;  // posted events, dispatched by tick
+    const sm_event   *event;   // event being dispatched
+    
+    const struct _sm_sealed *sealed;  // compiled layout, NULL before sealing
+    
+    struct _sm_fleet *fleet;        // batch ticking, NULL for none
+    unsigned int      fleet_index;  // position in the fleet
+    
     // methods
     sm_machine_current current_state;
     
@@ -0,0 +1,282 @@
+//
+//  sm_scheduler.c
+//  FiniteStateMachine
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "ds_futex.h"
+
+#include "sm_machine.h"
+#include "sm_scheduler.h"
+
+// wait until the word is not 'value', spin first
+static inline unsigned int sm_scheduler_wait(atomic_uint *word, unsigned int value)
+{
+    unsigned int current;
+    for (unsigned int spins = 0; ; ++spins) {
+        current = atomic_load_explicit(word, memory_order_acquire);
+        if (current != value) {
+            return current;
+        } else if (spins < SM_SCHEDULER_SPIN_COUNT) {
+            ds_cpu_relax();
+        } else {
+            ds_futex_wait(word, value, 0);
+        }
+    }
+}
+
+static inline void sm_scheduler_run_shard(sm_scheduler *scheduler, sm_fleet *shard)
+{
+    sm_tick_machines(shard, scheduler->now, scheduler->elapsed);
+    if (atomic_fetch_sub_explicit(&scheduler->pending, 1, memory_order_acq_rel) == 1) {
+        // all shards done, wake up the idle workers parked
+        ds_futex_wake(&scheduler->pending, DS_FUTEX_WAKE_ALL);
+    }
+}
+
+// back off when nothing to steal: spin, then yield, then park
+static inline void sm_worker_idle(sm_scheduler *scheduler, unsigned int pending, unsigned int idle)
+{
+    if (idle < 8) {
+        for (unsigned int spins = 1u << idle; spins > 0; --spins) {
+            ds_cpu_relax();
+        }
+    } else if (idle < SM_SCHEDULER_IDLE_COUNT) {
+        sched_yield();
+    } else {
+        // the remaining shards are taken by the others
+        ds_futex_wait(&scheduler->pending, pending, 0);
+    }
+}
+
+// steal one shard from a random peer
+static inline sm_bool sm_worker_steal(sm_worker *worker, sm_fleet **shard)
+{
+    sm_scheduler *scheduler = worker->scheduler;
+    unsigned int count = scheduler->workers_count;
+    // xorshift
+    unsigned int seed = worker->seed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    worker->seed = seed;
+    unsigned int victim;
+    ds_data item;
+    for (unsigned int index = 0; index < count; ++index) {
+        victim = (seed + index) % count;
+        if (victim == worker->id) {
+            continue;
+        }
+        if (ds_ws_deque_steal(scheduler->workers[victim].deque, &item) == DSWorkStealSuccess) {
+            *shard = (sm_fleet *)item;
+            return SMTrue;
+        }
+    }
+    return SMFalse;
+}
+
+static void *sm_worker_run(void *arg)
+{
+    sm_worker *worker = (sm_worker *)arg;
+    sm_scheduler *scheduler = worker->scheduler;
+    unsigned int round = 0;
+    ds_data item;
+    sm_fleet *shard;
+    unsigned int pending, idle;
+    for (;;) {
+        // 1. wait for next tick
+        round = sm_scheduler_wait(&scheduler->round, round);
+        if (atomic_load_explicit(&scheduler->stopped, memory_order_acquire)) {
+            break;
+        }
+        // 2. take home shards
+        for (unsigned int index = worker->id; index < scheduler->count;
+             index += scheduler->workers_count) {
+            ds_ws_deque_push(worker->deque, (ds_data)scheduler->shards[index]);
+        }
+        // 3. tick own shards, then help the others
+        idle = 0;
+        while ((pending = atomic_load_explicit(&scheduler->pending, memory_order_acquire)) > 0) {
+            if (ds_ws_deque_pop(worker->deque, &item)) {
+                sm_scheduler_run_shard(scheduler, (sm_fleet *)item);
+                idle = 0;
+            } else if (sm_worker_steal(worker, &shard)) {
+                sm_scheduler_run_shard(scheduler, shard);
+                idle = 0;
+            } else {
+                sm_worker_idle(scheduler, pending, idle++);
+            }
+        }
+        // 4. the last worker leaving wakes up the ticking thread
+        if (atomic_fetch_sub_explicit(&scheduler->active, 1, memory_order_acq_rel) == 1) {
+            atomic_fetch_add_explicit(&scheduler->finished, 1, memory_order_release);
+            ds_futex_wake(&scheduler->finished, 1);
+        }
+    }
+    return NULL;
+}
+
+// stop and join the first 'started' workers, then free the scheduler
+static void sm_scheduler_release(sm_scheduler *scheduler, unsigned int started)
+{
+    atomic_store(&scheduler->stopped, 1);
+    atomic_fetch_add(&scheduler->round, 1);
+    ds_futex_wake(&scheduler->round, DS_FUTEX_WAKE_ALL);
+    sm_worker *worker;
+    for (unsigned int index = 0; index < scheduler->workers_count; ++index) {
+        worker = scheduler->workers + index;
+        if (index < started) {
+            pthread_join(worker->thread, NULL);
+        }
+        if (worker->deque != NULL) {
+            ds_ws_deque_destroy(worker->deque);
+        }
+    }
+    free(scheduler->workers);
+    free(scheduler->shards);
+    free(scheduler);
+}
+
+sm_scheduler *sm_create_scheduler(unsigned int workers)
+{
+    // aligned to cache line for the padded words
+    void *ptr = NULL;
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, sizeof(sm_scheduler)) != 0) {
+        return NULL;
+    }
+    sm_scheduler *scheduler = (sm_scheduler *)ptr;
+    memset(scheduler, 0, sizeof(sm_scheduler));
+    atomic_init(&scheduler->round, 0);
+    atomic_init(&scheduler->stopped, 0);
+    atomic_init(&scheduler->pending, 0);
+    atomic_init(&scheduler->active, 0);
+    atomic_init(&scheduler->finished, 0);
+    scheduler->capacity = 8;
+    scheduler->shards = (sm_fleet **)malloc(scheduler->capacity * sizeof(sm_fleet *));
+    
+    // start workers
+    if (workers == 0) {
+        workers = 1;
+    }
+    if (posix_memalign(&ptr, DS_CACHE_LINE_SIZE, workers * sizeof(sm_worker)) != 0) {
+        free(scheduler->shards);
+        free(scheduler);
+        return NULL;
+    }
+    scheduler->workers = (sm_worker *)ptr;
+    memset(scheduler->workers, 0, workers * sizeof(sm_worker));
+    scheduler->workers_count = workers;
+    sm_worker *worker;
+    for (unsigned int index = 0; index < workers; ++index) {
+        worker = scheduler->workers + index;
+        worker->scheduler = scheduler;
+        worker->id = index;
+        worker->seed = 2463534242u + index * 2654435769u;
+        worker->deque = ds_ws_deque_create(16);
+        if (worker->deque == NULL) {
+            sm_scheduler_release(scheduler, 0);
+            return NULL;
+        }
+    }
+    for (unsigned int index = 0; index < workers; ++index) {
+        worker = scheduler->workers + index;
+        if (pthread_create(&worker->thread, NULL, sm_worker_run, worker) != 0) {
+            // stop the workers started
+            sm_scheduler_release(scheduler, index);
+            return NULL;
+        }
+    }
+    return scheduler;
+}
+
+void sm_destroy_scheduler(sm_scheduler *scheduler)
+{
+    // 1. destroy shards (machines are detached)
+    for (unsigned int index = 0; index < scheduler->count; ++index) {
+        sm_destroy_fleet(scheduler->shards[index]);
+    }
+    // 2. stop workers
+    sm_scheduler_release(scheduler, scheduler->workers_count);
+}
+
+void sm_scheduler_add(sm_scheduler *scheduler, sm_machine *machine)
+{
+    if (machine->fleet != NULL) {
+        // in a fleet already
+        return;
+    }
+    // any shard with room
+    sm_fleet *shard = NULL;
+    for (unsigned int index = 0; index < scheduler->count; ++index) {
+        if (scheduler->shards[index]->count < SM_SCHEDULER_SHARD_SIZE) {
+            shard = scheduler->shards[index];
+            break;
+        }
+    }
+    if (shard == NULL) {
+        // new shard
+        if (scheduler->count == scheduler->capacity) {
+            scheduler->capacity *= 2;
+            scheduler->shards = (sm_fleet **)realloc(scheduler->shards,
+                                                     scheduler->capacity * sizeof(sm_fleet *));
+        }
+        shard = sm_create_fleet(SM_SCHEDULER_SHARD_SIZE);
+        scheduler->shards[scheduler->count++] = shard;
+    }
+    sm_fleet_add(shard, machine);
+}
+
+void sm_scheduler_remove(sm_scheduler *scheduler, sm_machine *machine)
+{
+    sm_fleet *shard = machine->fleet;
+    for (unsigned int index = 0; index < scheduler->count; ++index) {
+        if (scheduler->shards[index] == shard) {
+            sm_fleet_remove(shard, machine);
+            if (shard->count == 0) {
+                // destroy the empty shard, move the last one here
+                sm_destroy_fleet(shard);
+                scheduler->shards[index] = scheduler->shards[--scheduler->count];
+            }
+            break;
+        }
+    }
+}
+
+// destroy the shards emptied by destroying machines directly
+static inline void sm_scheduler_prune(sm_scheduler *scheduler)
+{
+    unsigned int index = 0;
+    while (index < scheduler->count) {
+        if (scheduler->shards[index]->count > 0) {
+            ++index;
+            continue;
+        }
+        sm_destroy_fleet(scheduler->shards[index]);
+        scheduler->shards[index] = scheduler->shards[--scheduler->count];
+    }
+}
+
+void sm_scheduler_tick(sm_scheduler *scheduler, const sm_time now, const sm_time elapsed)
+{
+    sm_scheduler_prune(scheduler);
+    if (scheduler->count == 0) {
+        return;
+    }
+    unsigned int finished = atomic_load(&scheduler->finished);
+    scheduler->now = now;
+    scheduler->elapsed = elapsed;
+    atomic_store(&scheduler->pending, scheduler->count);
+    atomic_store(&scheduler->active, (int)scheduler->workers_count);
+    // start
+    atomic_fetch_add_explicit(&scheduler->round, 1, memory_order_release);
+    ds_futex_wake(&scheduler->round, DS_FUTEX_WAKE_ALL);
+    // wait for all shards done, and all workers left
+    // (so the shards can be changed after returned)
+    sm_scheduler_wait(&scheduler->finished, finished);
+}
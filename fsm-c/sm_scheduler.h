@@ -0,0 +1,96 @@
+//
+//  sm_scheduler.h
+//  FiniteStateMachine
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __sm_scheduler__
+#define __sm_scheduler__
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "ds_ws_deque.h"
+
+#include "sm_fleet.h"
+
+//
+//  Multi-threaded scheduler
+//
+//      Machines are partitioned into shards (a fleet of at most
+//  'SM_SCHEDULER_SHARD_SIZE' machines), and each shard has a home worker.
+//  On every tick, the workers push their home shards into their own work
+//  stealing deques and tick them (by 'sm_tick_machines'); a worker idle
+//  steals shards from its peers, so the load is balanced.
+//
+//      A shard is taken by exactly one worker in a tick, and the tick returns
+//  after all shards are done and all workers are back to waiting, so the
+//  callbacks of a machine never run concurrently; but machines of different
+//  shards run at the same time, so they must not share unguarded data.
+//
+//      Machines can be added/removed only between ticks; a new machine goes
+//  into any shard with room, and a shard emptied by removing is destroyed. So are the events:
+//  the queue of posted events is not thread-safe, it's drained by the worker
+//  ticking the machine, so 'sm_post_event' may only be called between ticks,
+//  or during a tick by the callbacks of the same machine (on its own worker);
+//  posting to a machine of another shard while ticking is a data race.
+//
+
+#ifndef SM_SCHEDULER_SHARD_SIZE
+#define SM_SCHEDULER_SHARD_SIZE   1024
+#endif
+
+#ifndef SM_SCHEDULER_SPIN_COUNT
+#define SM_SCHEDULER_SPIN_COUNT   1000
+#endif
+
+// failed steals before an idle worker parks until the tick is done
+#ifndef SM_SCHEDULER_IDLE_COUNT
+#define SM_SCHEDULER_IDLE_COUNT   16
+#endif
+
+struct _sm_scheduler;
+
+typedef struct _sm_worker {
+    _Alignas(DS_CACHE_LINE_SIZE) struct _sm_scheduler *scheduler;
+    unsigned int id;
+    unsigned int seed;  // for choosing victims
+    pthread_t    thread;
+    ds_ws_deque *deque; // shards to tick
+} sm_worker;
+
+typedef struct _sm_scheduler {
+
+    // tick in progress
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_uint round;  // futex word for workers
+    atomic_int stopped;
+    sm_time    now;
+    sm_time    elapsed;
+
+    _Alignas(DS_CACHE_LINE_SIZE) atomic_uint pending;  // shards not ticked, futex word for idle workers
+    atomic_int  active;    // workers not finished
+    atomic_uint finished;  // futex word for the ticking thread
+
+    // shards
+    unsigned int capacity;
+    unsigned int count;
+    sm_fleet   **shards;
+
+    // workers
+    unsigned int workers_count;
+    sm_worker   *workers;
+} sm_scheduler;
+
+sm_scheduler *sm_create_scheduler(unsigned int workers);
+void sm_destroy_scheduler(sm_scheduler *scheduler);  // machines are not destroyed
+
+// machines (not while ticking)
+void sm_scheduler_add   (sm_scheduler *scheduler, sm_machine *machine);
+void sm_scheduler_remove(sm_scheduler *scheduler, sm_machine *machine);
+
+// tick all machines by the workers, return after all done
+void sm_scheduler_tick(sm_scheduler *scheduler, const sm_time now, const sm_time elapsed);
+
+#endif /* defined(__sm_scheduler__) */
@@ -0,0 +1,102 @@
+//
+//  sm_sealed.c
+//  FiniteStateMachine
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sm_list.h"
+#include "sm_state.h"
+#include "sm_event.h"
+#include "sm_sealed.h"
+
+sm_sealed *sm_create_sealed(const sm_machine *machine)
+{
+    // 1. count states & transitions
+    unsigned int states_count = sm_list_length(machine->states);
+    unsigned int transitions_count = 0;
+    sm_list_cursor cursor;
+    sm_state *state;
+    SM_LIST_FOR_EACH_ITEM(machine->states, cursor, state) {
+        if (state == NULL) {
+            // state index not continuous
+            return NULL;
+        }
+        transitions_count += sm_list_length(state->transitions);
+        if (state->events != NULL) {
+            // event transitions are not compiled, but their targets must be valid too
+            const sm_event_table *table = state->events;
+            for (unsigned int index = 0; index < table->entries_count; ++index) {
+                if (table->entries[index].trans->target >= states_count) {
+                    return NULL;
+                }
+            }
+        }
+    }
+    
+    // 2. one block for all
+    size_t len = sizeof(sm_sealed)
+               + (states_count + 1) * sizeof(sm_sealed_state)
+               + transitions_count * sizeof(sm_sealed_transition);
+    sm_sealed *sealed = (sm_sealed *)malloc(len);
+    sm_sealed_state *states = (sm_sealed_state *)(sealed + 1);
+    sm_sealed_transition *transitions = (sm_sealed_transition *)(states + states_count + 1);
+    sealed->states_count = states_count;
+    sealed->transitions_count = transitions_count;
+    sealed->states = states;
+    sealed->transitions = transitions;
+    
+    // 3. fill the rows
+    unsigned int index = 0;
+    sm_list_cursor pos;
+    sm_transition *trans;
+    SM_LIST_FOR_EACH_ITEM(machine->states, cursor, state) {
+        states->state = state;
+        states->evaluate = state->evaluate == sm_tick_state ? NULL : state->evaluate;
+        states->first = index;
+        ++states;
+        SM_LIST_FOR_EACH_ITEM(state->transitions, pos, trans) {
+            if (trans->target >= states_count) {
+                // target state not found
+                free(sealed);
+                return NULL;
+            }
+            transitions->evaluate = trans->evaluate;
+            transitions->trans = trans;
+            transitions->target = trans->target;
+            ++transitions;
+            ++index;
+        }
+    }
+    // end of the last row
+    states->state = NULL;
+    states->evaluate = NULL;
+    states->first = index;
+    return sealed;
+}
+
+void sm_destroy_sealed(sm_sealed *sealed)
+{
+    free(sealed);
+}
+
+// state evaluate over the sealed layout
+const sm_sealed_transition *sm_tick_sealed(const sm_sealed  *sealed,
+                                           unsigned int      current,
+                                           const sm_context *ctx,
+                                           const sm_time     now)
+{
+    const sm_sealed_transition *trans = sealed->transitions + sealed->states[current].first;
+    const sm_sealed_transition *end = sealed->transitions + sealed->states[current + 1].first;
+    for (; trans < end; ++trans) {
+        if (trans->evaluate(trans->trans, ctx, now) != SMFalse) {
+            // OK, get target state from this transition
+            return trans;
+        }
+    }
+    return NULL;
+}
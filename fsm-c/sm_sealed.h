@@ -0,0 +1,59 @@
+//
+//  sm_sealed.h
+//  FiniteStateMachine
+//
+//  Created by Albert Moky on 2026/10/19.
+//  Copyright © 2026 DIM Group. All rights reserved.
+//
+
+#ifndef __sm_sealed__
+#define __sm_sealed__
+
+#include "sm_protocol.h"
+
+//
+//  Sealed machine layout
+//
+//      After all states and transitions are added, the machine can be sealed:
+//  they are compiled into one contiguous block, a state array and a transition
+//  array in compressed sparse row (CSR) form, transitions of state 'i' are in
+//  [states[i].first, states[i + 1].first), so a tick reads the current state
+//  and its transitions sequentially, no list or pointer chasing.
+//
+//      The block is read-only, the states and transitions must not be changed
+//  after sealing: adding states to a sealed machine or transitions (polling
+//  or event ones) to its states is refused, and 'state->evaluate' is copied,
+//  so it's frozen too. Sealing fails if a state is missing or a transition
+//  targets no state.
+//
+
+typedef struct _sm_sealed_transition {
+    sm_transition_evaluate evaluate;
+    const sm_transition   *trans;   // passed to evaluate (for its ctx)
+    unsigned int           target;  // target state index
+} sm_sealed_transition;
+
+typedef struct _sm_sealed_state {
+    sm_state          *state;
+    sm_state_evaluate  evaluate;  // custom evaluate, NULL for walking the transitions
+    unsigned int       first;     // first transition of this state
+} sm_sealed_state;
+
+typedef struct _sm_sealed {
+    unsigned int states_count;
+    unsigned int transitions_count;
+    const sm_sealed_state      *states;       // states_count + 1 (end of CSR)
+    const sm_sealed_transition *transitions;
+} sm_sealed;
+
+// compile states & transitions of the machine, NULL when any state missing
+sm_sealed *sm_create_sealed(const sm_machine *machine);
+void sm_destroy_sealed(sm_sealed *sealed);
+
+// state evaluate over the sealed layout
+const sm_sealed_transition *sm_tick_sealed(const sm_sealed  *sealed,
+                                           unsigned int      current,
+                                           const sm_context *machine,
+                                           const sm_time     now);
+
+#endif /* defined(__sm_sealed__) */
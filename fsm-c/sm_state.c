@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include "sm_list.h"
+#include "sm_event.h"
 #include "sm_machine.h"
 #include "sm_transition.h"
 #include "sm_state.h"
@@ -30,6 +31,9 @@ void sm_destroy_state(sm_state *state)
 {
     // 1. destroy the chain table for transitions
     sm_list_destroy(state->transitions);
+    if (state->events != NULL) {
+        sm_destroy_event_table(state->events);
+    }
     
     // state->transitions = NULL;
     // state->ctx = NULL;
@@ -40,6 +44,10 @@ void sm_destroy_state(sm_state *state)
 
 void sm_add_transition(sm_state *state, const sm_transition *trans)
 {
+    if (state->sealed) {
+        // the machine is sealed
+        return;
+    }
     sm_list_add(state->transitions, (sm_list_item)trans);
 }
 
@@ -48,10 +56,10 @@ const struct _sm_transition *sm_tick_state(const sm_state   *state,
                                            const sm_context *ctx,
                                            const sm_time     now)
 {
+    const sm_list *transitions = state->transitions;
+    sm_list_cursor cursor;
     sm_transition * trans;
-    unsigned int len = sm_list_length(state->transitions);
-    for (unsigned int index = 0; index < len; ++index) {
-        trans = sm_list_get(state->transitions, index);
+    SM_LIST_FOR_EACH_ITEM(transitions, cursor, trans) {
         if (trans->evaluate(trans, ctx, now) != SMFalse) {
             // OK, get target state from this transition
             return trans;
@@ -59,3 +67,38 @@ const struct _sm_transition *sm_tick_state(const sm_state   *state,
     }
     return NULL;
 }
+
+void sm_add_event_transition(sm_state *state, sm_event_id event, const sm_transition *trans)
+{
+    if (state->sealed) {
+        // the machine is sealed
+        return;
+    }
+    if (state->events == NULL) {
+        state->events = sm_create_event_table(4);
+    }
+    sm_event_table_add(state->events, event, trans);
+}
+
+// state evaluate for the event
+const struct _sm_transition *sm_event_state(const sm_state   *state,
+                                            const sm_event   *event,
+                                            const sm_context *ctx,
+                                            const sm_time     now)
+{
+    const sm_event_table *table = state->events;
+    if (table == NULL) {
+        return NULL;
+    }
+    const sm_event_entry *entry;
+    int index = sm_event_table_find(table, event->id);
+    for (; index >= 0; index = entry->next) {
+        entry = table->entries + index;
+        if (entry->trans->evaluate == NULL ||
+            entry->trans->evaluate(entry->trans, ctx, now) != SMFalse) {
+            // OK, get target state from this transition
+            return entry->trans;
+        }
+    }
+    return NULL;
+}
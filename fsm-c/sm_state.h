@@ -15,6 +15,7 @@
 sm_state *sm_create_state(sm_state_evaluate evaluate, unsigned int capacity);
 void sm_destroy_state(sm_state *state);
 
+// (ignored after the machine is sealed)
 void sm_add_transition(sm_state *state, const sm_transition *trans);
 
 // state evaluate
@@ -22,5 +23,14 @@ const struct _sm_transition *sm_tick_state(const sm_state   *state,
                                            const sm_context *machine,
                                            const sm_time     now);
 
+// transitions triggered by event id (ignored after the machine is sealed)
+void sm_add_event_transition(sm_state *state, sm_event_id event, const sm_transition *trans);
+
+// state evaluate for the event (transitions without evaluate always pass)
+const struct _sm_transition *sm_event_state(const sm_state   *state,
+                                            const sm_event   *event,
+                                            const sm_context *machine,
+                                            const sm_time     now);
+
 
 #endif /* defined(__sm_state__) */